@@ -0,0 +1,551 @@
+// Stage throughput benchmark (slime checks, row fills, work units and the rectangle
+// stage), plus the original-vs-scanner comparison on synthetic dense grids.
+// Usage: benchmark [--json FILE] [--min-ms MS] [--scaling]   (FILE "-" writes the JSON to stdout)
+#include "megaslimechunkfinder.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <algorithm>
+#include <tuple>
+#include <bitset>
+#include <new>
+#include <cstdlib>
+#include <thread>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+// Every heap allocation in the process goes through here, so a stage's allocations are
+// the difference of the counter around it
+static std::atomic<int64_t> allocationCount{0};
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// Original implementation: full int64 height matrix, and every start column extends
+// right for as long as the heights stay non-zero
+static void findRectanglesOriginal(const SlimeGrid& grid, int64_t minimumRectDimension,
+                                   std::vector<Rectangle>& results) {
+    int64_t rows = grid.rows;
+    int64_t cols = grid.cols;
+    
+    std::vector<std::vector<int64_t>> heights(rows, std::vector<int64_t>(cols, 0));
+    for (int64_t i = 0; i < rows; i++) {
+        for (int64_t j = 0; j < cols; j++) {
+            if (grid.get(i, j)) {
+                heights[i][j] = (i == 0) ? 1 : heights[i-1][j] + 1;
+            }
+        }
+    }
+    
+    for (int64_t row = 0; row < rows; row++) {
+        const std::vector<int64_t>& height = heights[row];
+        for (int64_t i = 0; i < cols; i++) {
+            if (!grid.get(row, i)) continue;
+            
+            int64_t minHeight = height[i];
+            for (int64_t j = i; j < cols && height[j] > 0; j++) {
+                minHeight = std::min(minHeight, height[j]);
+                int64_t width = j - i + 1;
+                if (width >= minimumRectDimension && minHeight >= minimumRectDimension) {
+                    Rectangle rect;
+                    rect.x = i;
+                    rect.z = row - minHeight + 1;
+                    rect.width = width;
+                    rect.height = minHeight;
+                    rect.area = width * minHeight;
+                    rect.distanceSquared = 0;
+                    results.push_back(rect);
+                }
+            }
+        }
+    }
+}
+
+// Same LCG as the test suite's synthetic grids
+static uint64_t nextRandom(uint64_t& state) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return state >> 33;
+}
+
+struct DenseCase {
+    const char* name;
+    int64_t rows, cols, n;
+    void (*fill)(SlimeGrid& grid, int64_t n);
+};
+
+// Full rows broken by an empty row every n rows: long runs that never get tall enough,
+// plus one full column so the tall-row precheck can't skip them
+static void fillStripes(SlimeGrid& grid, int64_t n) {
+    for (int64_t r = 0; r < grid.rows; r++) {
+        for (int64_t c = 0; c < grid.cols; c++) {
+            if (r % n != n - 1 || c == 0) grid.set(r, c);
+        }
+    }
+}
+
+// 97% random fill, so most runs are wide and a few columns grow tall
+static void fillDense(SlimeGrid& grid, int64_t) {
+    uint64_t state = 42;
+    for (int64_t r = 0; r < grid.rows; r++) {
+        for (int64_t c = 0; c < grid.cols; c++) {
+            if (nextRandom(state) % 1000 < 970) grid.set(r, c);
+        }
+    }
+}
+
+// Slime-like 10% fill
+static void fillSparse(SlimeGrid& grid, int64_t) {
+    uint64_t state = 7;
+    for (int64_t r = 0; r < grid.rows; r++) {
+        for (int64_t c = 0; c < grid.cols; c++) {
+            if (nextRandom(state) % 10 == 0) grid.set(r, c);
+        }
+    }
+}
+
+// Slime-like random fill at density permille / 1000
+static void fillRandom(SlimeGrid& grid, int64_t permille, uint64_t state) {
+    for (int64_t r = 0; r < grid.rows; r++) {
+        for (int64_t c = 0; c < grid.cols; c++) {
+            if ((int64_t)(nextRandom(state) % 1000) < permille) grid.set(r, c);
+        }
+    }
+}
+
+template <typename F>
+static double timeMs(F&& run, int repeats) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < repeats; r++) {
+        run();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / repeats;
+}
+
+// One measured stage. A call is one unit of work (a batch of checks, a row, a work unit
+// or a grid); chunks is the number of chunks one call covers.
+struct StageResult {
+    std::string stage;
+    std::string variant;
+    int64_t chunks = 0;
+    int64_t calls = 0;
+    double nsPerChunk = 0;
+    double cyclesPerChunk = 0;      // TSC reference cycles, not core clocks
+    double allocationsPerCall = 0;
+    int64_t checksum = 0;           // Keeps the work observable; also lets runs be compared
+};
+
+// Repeat run() until minMs has passed (at least twice, the first call is a warm-up)
+template <typename F>
+static StageResult measureStage(const std::string& stage, const std::string& variant, int64_t chunks,
+                                double minMs, F&& run) {
+    StageResult result;
+    result.stage = stage;
+    result.variant = variant;
+    result.chunks = chunks;
+    result.checksum = run();
+
+    int64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    uint64_t tscStart = __rdtsc();
+    double elapsedMs = 0;
+    do {
+        run();
+        result.calls++;
+        elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsedMs < minMs);
+    uint64_t tscEnd = __rdtsc();
+    int64_t allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+    double totalChunks = (double)chunks * result.calls;
+    result.nsPerChunk = elapsedMs * 1e6 / totalChunks;
+    result.cyclesPerChunk = (double)(tscEnd - tscStart) / totalChunks;
+    result.allocationsPerCall = (double)allocations / result.calls;
+    return result;
+}
+
+static std::vector<StageResult> runStageSuite(SimdLevel simdLevel, double minMs) {
+    const int64_t worldSeed = 413563856LL;
+    const int64_t unitSize = WORK_UNIT_SIZE;
+    const int64_t originX = 93750, originZ = -156250;   // Away from the axes, inside the int32 range
+    std::vector<StageResult> results;
+
+    // Single checks over a 64 x 1024 block
+    const int64_t blockRows = 64, blockCols = 1024;
+    results.push_back(measureStage("isSlimeChunk", "scalar", blockRows * blockCols, minMs, [&] {
+        int64_t count = 0;
+        for (int64_t z = 0; z < blockRows; z++) {
+            for (int64_t x = 0; x < blockCols; x++) {
+                count += isSlimeChunk(originX + x, originZ + z, worldSeed);
+            }
+        }
+        return count;
+    }));
+    if (simdLevel >= SimdLevel::AVX512) {
+        results.push_back(measureStage("isSlimeChunkVec16", "avx512", blockRows * blockCols, minMs, [&] {
+            alignas(64) int64_t chunkX[16];
+            alignas(64) int64_t chunkZ[16];
+            int64_t count = 0;
+            for (int64_t z = 0; z < blockRows; z++) {
+                for (int64_t x = 0; x < blockCols; x += 16) {
+                    for (int i = 0; i < 16; i++) {
+                        chunkX[i] = originX + x + i;
+                        chunkZ[i] = originZ + z;
+                    }
+                    count += (int64_t)std::bitset<16>(isSlimeChunkVec16(chunkX, chunkZ, worldSeed)).count();
+                }
+            }
+            return count;
+        }));
+    }
+    if (simdLevel >= SimdLevel::AVX2) {
+        results.push_back(measureStage("isSlimeChunkVec8", "avx2", blockRows * blockCols, minMs, [&] {
+            alignas(32) int64_t chunkX[8];
+            alignas(32) int64_t chunkZ[8];
+            int64_t count = 0;
+            for (int64_t z = 0; z < blockRows; z++) {
+                for (int64_t x = 0; x < blockCols; x += 8) {
+                    for (int i = 0; i < 8; i++) {
+                        chunkX[i] = originX + x + i;
+                        chunkZ[i] = originZ + z;
+                    }
+                    count += (int64_t)std::bitset<8>(isSlimeChunkVec8(chunkX, chunkZ, worldSeed)).count();
+                }
+            }
+            return count;
+        }));
+    }
+
+    // Grid fill: every row of one work unit through each supported kernel
+    SlimeGrid grid(unitSize, unitSize);
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (level > simdLevel) continue;
+        const SlimeKernel& kernel = slimeKernelFor(level);
+        for (GridEngine engine : {GridEngine::Batch, GridEngine::RowIncremental}) {
+            auto fill = (engine == GridEngine::Batch) ? kernel.fillRowBatch : kernel.fillRowIncremental;
+            std::string variant = std::string(simdLevelName(level)) + "/" + gridEngineName(engine);
+            results.push_back(measureStage("gridFill", variant, unitSize * unitSize, minMs, [&] {
+                int64_t count = 0;
+                for (int64_t r = 0; r < unitSize; r++) {
+                    fill(originX, originZ + r, unitSize, worldSeed, grid.row(r));
+                    count += (int64_t)grid.row(r)[0] & 1;
+                }
+                return count;
+            }));
+        }
+    }
+
+    // Whole work units as the workers run them: fill plus rectangle stage
+    const int64_t minimumRectDimension = 3;
+    int64_t searchMin = -30000000, searchMax = 30000000;
+    std::atomic<int64_t> chunksProcessed{0};
+    for (RectFilter filter : {RectFilter::SquareAnd, RectFilter::None}) {
+        EngineConfig engines;
+        engines.simdLevel = simdLevel;
+        engines.rectFilter = filter;
+        std::vector<Rectangle> found;
+        results.push_back(measureStage("processRegion", rectFilterName(filter), unitSize * unitSize, minMs, [&] {
+            found.clear();
+            processRegion(originX, originX + unitSize, originZ, originZ + unitSize, worldSeed,
+                          minimumRectDimension, 0, searchMin, searchMax, searchMin, searchMax,
+                          found, chunksProcessed, engines);
+            return (int64_t)found.size();
+        }));
+
+        WorkUnit unit{originX, originX + unitSize, originZ, originZ + unitSize, 0};
+        UnitEdges edges;
+        results.push_back(measureStage("processUnitSeamed", rectFilterName(filter), unitSize * unitSize, minMs, [&] {
+            found.clear();
+            processUnitSeamed(unit, worldSeed, minimumRectDimension, 0, edges, found, true, engines);
+            return (int64_t)found.size();
+        }));
+
+        // The same with the worker's reusable arena, which allocates nothing once warm
+        int64_t arenaSide = paddedUnitSide(unitSize, minimumRectDimension);
+        UnitArena arena(arenaSide, arenaSide, simdLevel);
+        std::string reused = std::string(rectFilterName(filter)) + "/arena";
+        results.push_back(measureStage("processRegion", reused, unitSize * unitSize, minMs, [&] {
+            found.clear();
+            processRegion(originX, originX + unitSize, originZ, originZ + unitSize, worldSeed,
+                          minimumRectDimension, 0, searchMin, searchMax, searchMin, searchMax,
+                          found, chunksProcessed, engines, false, &arena);
+            return (int64_t)found.size();
+        }));
+        results.push_back(measureStage("processUnitSeamed", reused, unitSize * unitSize, minMs, [&] {
+            found.clear();
+            processUnitSeamed(unit, worldSeed, minimumRectDimension, 0, edges, found, true, engines,
+                              false, &arena);
+            return (int64_t)found.size();
+        }));
+    }
+
+    // Rectangle stage alone on synthetic grids of controlled density
+    for (int64_t permille : {100, 500, 900}) {
+        SlimeGrid synthetic(unitSize, unitSize);
+        fillRandom(synthetic, permille, 1234 + permille);
+        for (RectMode mode : {RectMode::Maximal, RectMode::Exhaustive}) {
+            // Exhaustive mode reports every sub-rectangle, which explodes on dense grids
+            if (mode == RectMode::Exhaustive && permille > 500) continue;
+            std::vector<Rectangle> found;
+            std::string variant = std::string(rectModeName(mode)) + "/density" + std::to_string(permille / 10);
+            results.push_back(measureStage("findMaximalRectangles", variant, unitSize * unitSize, minMs, [&] {
+                found.clear();
+                findMaximalRectangles(synthetic, 0, synthetic.rows, 0, 0, minimumRectDimension, found, mode,
+                                      0, false, simdLevel);
+                return (int64_t)found.size();
+            }));
+        }
+    }
+    return results;
+}
+
+// One whole search over a fixed region: strong scaling, so the work stays the same as the
+// thread count grows
+struct ScalingResult {
+    std::string scheduler;
+    int64_t threads = 0;
+    int64_t nodes = 0;              // NUMA nodes the workers were pinned across
+    double seconds = 0;             // Best of the repeats
+    double chunksPerSecond = 0;
+    double speedup = 0;             // Against one thread of the same scheduler
+    double efficiency = 0;          // speedup / threads
+    int64_t steals = 0;
+    int64_t rectangles = 0;
+};
+
+// Runs the finder's workers, pinned the way the finder pins them, with 1, 2, 4, ...
+// threads up to every CPU, under both schedulers
+static std::vector<ScalingResult> runScalingSuite(SimdLevel simdLevel) {
+    const int64_t worldSeed = 413563856LL;
+    const int64_t radius = 8192;        // Chunks; 268M chunks in 4096 units
+    const int64_t unitSize = 256;
+    const int repeats = 3;
+    int64_t searchMin = -radius * 16, searchMax = radius * 16;
+
+    std::vector<std::vector<int>> nodes = detectNumaNodes();
+    int64_t cpus = 0;
+    for (const auto& node : nodes) {
+        cpus += (int64_t)node.size();
+    }
+    std::vector<int64_t> threadCounts;
+    for (int64_t threads = 1; threads < cpus; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(cpus);
+
+    std::vector<ScalingResult> results;
+    for (Scheduler scheduler : {Scheduler::Shared, Scheduler::Stealing}) {
+        double oneThreadSeconds = 0;
+        for (int64_t threadCount : threadCounts) {
+            std::vector<WorkerPlacement> placement = planWorkerPlacement(threadCount, nodes);
+            EngineConfig engines;
+            engines.simdLevel = simdLevel;
+            engines.scheduler = scheduler;
+            engines.placement = &placement;
+
+            ScalingResult result;
+            result.scheduler = schedulerName(scheduler);
+            result.threads = threadCount;
+            std::vector<char> usedNodes(nodes.size(), 0);
+            for (const WorkerPlacement& worker : placement) {
+                usedNodes[worker.node] = 1;
+            }
+            result.nodes = std::count(usedNodes.begin(), usedNodes.end(), 1);
+            for (int r = 0; r < repeats; r++) {
+                RectangleStore store;
+                std::atomic<bool> pauseFlag{false};
+                std::atomic<int64_t> chunksProcessed{0};
+                std::atomic<int64_t> maxDistanceReached{0};
+                SpiralWorkQueue workQueue(searchMin, searchMax, searchMin, searchMax, unitSize);
+                if (scheduler == Scheduler::Stealing) {
+                    workQueue.enableStealing(placement);
+                }
+                WorkProgress progress(workQueue.size());
+                SeamTracker seams(workQueue, progress);
+
+                auto start = std::chrono::steady_clock::now();
+                std::vector<std::thread> threads;
+                for (int64_t i = 0; i < threadCount; i++) {
+                    threads.emplace_back(workerThread, i, threadCount, worldSeed, 3,
+                                         searchMin, searchMax, searchMin, searchMax,
+                                         std::ref(store), std::ref(pauseFlag), std::ref(chunksProcessed),
+                                         std::ref(maxDistanceReached), std::ref(workQueue), std::ref(progress),
+                                         std::ref(seams), std::cref(engines), false);
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if (r == 0 || seconds < result.seconds) {
+                    result.seconds = seconds;
+                    result.chunksPerSecond = chunksProcessed.load() / seconds;
+                    result.steals = workQueue.steals();
+                }
+                result.rectangles = store.size();
+            }
+            if (threadCount == 1) {
+                oneThreadSeconds = result.seconds;
+            }
+            result.speedup = (oneThreadSeconds > 0) ? oneThreadSeconds / result.seconds : 0;
+            result.efficiency = result.speedup / threadCount;
+            results.push_back(result);
+        }
+    }
+    return results;
+}
+
+static void writeJson(std::ostream& out, SimdLevel simdLevel, const std::vector<StageResult>& results,
+                      const std::vector<ScalingResult>& scaling) {
+    out << "{\n  \"simd\": \"" << simdLevelName(simdLevel) << "\",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const StageResult& r = results[i];
+        out << "    {\"stage\": \"" << r.stage << "\", \"variant\": \"" << r.variant
+            << "\", \"chunks_per_call\": " << r.chunks << ", \"calls\": " << r.calls
+            << std::fixed << std::setprecision(4)
+            << ", \"ns_per_chunk\": " << r.nsPerChunk << ", \"cycles_per_chunk\": " << r.cyclesPerChunk
+            << ", \"allocations_per_call\": " << r.allocationsPerCall
+            << ", \"checksum\": " << r.checksum << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        out.unsetf(std::ios::fixed);
+    }
+    out << "  ],\n  \"scaling\": [\n";
+    for (size_t i = 0; i < scaling.size(); i++) {
+        const ScalingResult& r = scaling[i];
+        out << "    {\"scheduler\": \"" << r.scheduler << "\", \"threads\": " << r.threads
+            << ", \"numa_nodes\": " << r.nodes << std::fixed << std::setprecision(4)
+            << ", \"seconds\": " << r.seconds << ", \"chunks_per_second\": " << std::setprecision(0)
+            << r.chunksPerSecond << std::setprecision(4) << ", \"speedup\": " << r.speedup
+            << ", \"efficiency\": " << r.efficiency << ", \"steals\": " << r.steals
+            << ", \"rectangles\": " << r.rectangles << "}" << (i + 1 < scaling.size() ? "," : "") << "\n";
+        out.unsetf(std::ios::fixed);
+    }
+    out << "  ]\n}\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string jsonPath;
+    double minMs = 200;
+    bool scaling = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (arg == "--min-ms" && i + 1 < argc) {
+            minMs = std::atof(argv[++i]);
+        } else if (arg == "--scaling") {
+            scaling = true;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--json FILE] [--min-ms MS] [--scaling]\n";
+            return 2;
+        }
+    }
+    SimdLevel simdLevel = detectSimdLevel();
+
+    std::vector<StageResult> stages = runStageSuite(simdLevel, minMs);
+    std::cout << "Stage benchmark (" << simdLevelName(simdLevel) << ", " << WORK_UNIT_SIZE << "x"
+              << WORK_UNIT_SIZE << " units)\n";
+    std::cout << "==========================================================\n";
+    std::cout << std::left << std::setw(24) << "stage" << std::setw(22) << "variant" << std::right
+              << std::setw(10) << "ns/chunk" << std::setw(14) << "cycles/chunk" << std::setw(12) << "allocs/call"
+              << "\n";
+    for (const StageResult& r : stages) {
+        std::cout << std::left << std::setw(24) << r.stage << std::setw(22) << r.variant << std::right
+                  << std::fixed << std::setprecision(3) << std::setw(10) << r.nsPerChunk
+                  << std::setw(14) << r.cyclesPerChunk << std::setprecision(1) << std::setw(12)
+                  << r.allocationsPerCall << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+    std::cout << "\n";
+
+    std::vector<ScalingResult> scalingResults;
+    if (scaling) {
+        scalingResults = runScalingSuite(simdLevel);
+        std::cout << "Scaling (whole search, 268M chunks, 256-chunk units, pinned)\n";
+        std::cout << "==========================================================\n";
+        std::cout << std::left << std::setw(12) << "scheduler" << std::right << std::setw(8) << "threads"
+                  << std::setw(7) << "nodes" << std::setw(10) << "seconds" << std::setw(14) << "Mchunks/s"
+                  << std::setw(10) << "speedup" << std::setw(12) << "efficiency" << std::setw(8) << "steals" << "\n";
+        for (const ScalingResult& r : scalingResults) {
+            std::cout << std::left << std::setw(12) << r.scheduler << std::right << std::setw(8) << r.threads
+                      << std::setw(7) << r.nodes << std::fixed << std::setprecision(3) << std::setw(10) << r.seconds
+                      << std::setprecision(1) << std::setw(14) << r.chunksPerSecond / 1e6
+                      << std::setprecision(2) << std::setw(10) << r.speedup << std::setw(12) << r.efficiency
+                      << std::setw(8) << r.steals << "\n";
+            std::cout.unsetf(std::ios::fixed);
+        }
+        std::cout << "\n";
+    }
+
+    if (jsonPath == "-") {
+        writeJson(std::cout, simdLevel, stages, scalingResults);
+    } else if (!jsonPath.empty()) {
+        std::ofstream json(jsonPath);
+        if (!json.is_open()) {
+            std::cerr << "Cannot write " << jsonPath << "\n";
+            return 1;
+        }
+        writeJson(json, simdLevel, stages, scalingResults);
+    }
+
+    const DenseCase cases[] = {
+        {"stripes", 256, 1024, 4, fillStripes},
+        {"dense97", 256, 1024, 8, fillDense},
+        {"sparse10", 1024, 1024, 3, fillSparse},
+    };
+    
+    std::cout << "Rectangle stage benchmark (exhaustive mode, " << simdLevelName(simdLevel) << " height kernel)\n";
+    std::cout << "==========================================================\n";
+    std::cout << std::left << std::setw(10) << "grid" << std::setw(12) << "size" << std::setw(4) << "N"
+              << std::right << std::setw(14) << "original ms" << std::setw(14) << "scanner ms"
+              << std::setw(10) << "speedup" << std::setw(12) << "rects" << "\n";
+    
+    bool allMatch = true;
+    for (const DenseCase& tc : cases) {
+        SlimeGrid grid(tc.rows, tc.cols);
+        tc.fill(grid, tc.n);
+        
+        std::vector<Rectangle> original;
+        std::vector<Rectangle> scanned;
+        double originalMs = timeMs([&] {
+            original.clear();
+            findRectanglesOriginal(grid, tc.n, original);
+        }, 3);
+        double scannerMs = timeMs([&] {
+            scanned.clear();
+            findMaximalRectangles(grid, 0, grid.rows, 0, 0, tc.n, scanned, RectMode::Exhaustive, 0, false, simdLevel);
+        }, 3);
+        
+        auto sameRect = [](const Rectangle& a, const Rectangle& b) {
+            return a.x == b.x && a.z == b.z && a.width == b.width && a.height == b.height;
+        };
+        auto byPosition = [](const Rectangle& a, const Rectangle& b) {
+            return std::tie(a.z, a.x, a.width, a.height) < std::tie(b.z, b.x, b.width, b.height);
+        };
+        std::sort(original.begin(), original.end(), byPosition);
+        std::sort(scanned.begin(), scanned.end(), byPosition);
+        bool match = original.size() == scanned.size() &&
+                     std::equal(original.begin(), original.end(), scanned.begin(), sameRect);
+        allMatch = allMatch && match;
+        
+        std::cout << std::left << std::setw(10) << tc.name
+                  << std::setw(12) << (std::to_string(tc.rows) + "x" + std::to_string(tc.cols))
+                  << std::setw(4) << tc.n << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << originalMs << std::setw(14) << scannerMs
+                  << std::setw(9) << (originalMs / scannerMs) << "x" << std::setw(12) << scanned.size()
+                  << (match ? "" : "  MISMATCH") << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+    
+    return allMatch ? 0 : 1;
+}
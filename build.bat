@@ -33,11 +33,11 @@ REM Setup Visual Studio environment (suppress verbose output)
 call "%VSPATH%\VC\Auxiliary\Build\vcvars64.bat" >nul
 
 echo.
-echo Compiling main program with AVX-512 optimizations...
+echo Compiling main program (SIMD kernels are selected at runtime)...
 echo.
 
 REM Compile main program with maximum optimizations
-cl /std:c++17 /O2 /Oi /Ot /GL /arch:AVX512 /favor:INTEL64 /EHsc /nologo /Fe:megaslimechunkfinder.exe megaslimechunkfinder.cpp slimechunk_impl.cpp /link /LTCG
+cl /std:c++17 /O2 /Oi /Ot /GL /favor:INTEL64 /EHsc /nologo /Fe:megaslimechunkfinder.exe megaslimechunkfinder.cpp slimechunk_impl.cpp /link /LTCG
 
 set MAIN_SUCCESS=%ERRORLEVEL%
 
@@ -46,10 +46,28 @@ echo Compiling test program...
 echo.
 
 REM Compile test program
-cl /std:c++17 /O2 /Oi /Ot /GL /arch:AVX512 /favor:INTEL64 /EHsc /nologo /Fe:test_slimechunk.exe test_slimechunk.cpp slimechunk_impl.cpp /link /LTCG
+cl /std:c++17 /O2 /Oi /Ot /GL /favor:INTEL64 /EHsc /nologo /Fe:test_slimechunk.exe test_slimechunk.cpp slimechunk_impl.cpp /link /LTCG
 
 set TEST_SUCCESS=%ERRORLEVEL%
 
+echo.
+echo Compiling benchmark...
+echo.
+
+REM Compile stage benchmark
+cl /std:c++17 /O2 /Oi /Ot /GL /favor:INTEL64 /EHsc /nologo /Fe:benchmark.exe benchmark.cpp slimechunk_impl.cpp /link /LTCG
+
+set BENCH_SUCCESS=%ERRORLEVEL%
+
+echo.
+echo Compiling differential fuzzer...
+echo.
+
+REM Compile kernel and rectangle engine fuzzer
+cl /std:c++17 /O2 /Oi /Ot /GL /favor:INTEL64 /EHsc /nologo /Fe:fuzz_differential.exe fuzz_differential.cpp slimechunk_impl.cpp /link /LTCG
+
+set FUZZ_SUCCESS=%ERRORLEVEL%
+
 echo.
 echo ========================================
 if %MAIN_SUCCESS% EQU 0 (
@@ -65,6 +83,20 @@ if %TEST_SUCCESS% EQU 0 (
 ) else (
     echo Test program: FAILED
 )
+
+if %BENCH_SUCCESS% EQU 0 (
+    echo Benchmark: SUCCESSFUL
+    echo   Executable: benchmark.exe
+) else (
+    echo Benchmark: FAILED
+)
+
+if %FUZZ_SUCCESS% EQU 0 (
+    echo Fuzzer: SUCCESSFUL
+    echo   Executable: fuzz_differential.exe
+) else (
+    echo Fuzzer: FAILED
+)
 echo ========================================
 echo.
 
@@ -79,4 +111,14 @@ if %TEST_SUCCESS% EQU 0 (
     echo.
 )
 
+if %BENCH_SUCCESS% EQU 0 (
+    echo To run the stage benchmark: benchmark.exe [--json FILE]
+    echo.
+)
+
+if %FUZZ_SUCCESS% EQU 0 (
+    echo To cross-check the kernels and rectangle engines: fuzz_differential.exe [--chunks N] [--grids N]
+    echo.
+)
+
 pause
@@ -0,0 +1,536 @@
+// Differential fuzzer: every available slime kernel against isSlimeChunk, and every
+// rectangle engine against brute force on random grids. Cases are generated from the
+// fuzz seed and their index alone, so any mismatch can be rerun on its own.
+// Usage: fuzz_differential [--seed S] [--chunks N] [--grids N] [--threads N] [--row I | --grid I]
+#include "megaslimechunkfinder.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <tuple>
+#include <cerrno>
+#include <cstdlib>
+
+// Whole-argument decimal integer; trailing text or overflow is rejected
+static bool parseInt64Arg(const char* text, int64_t& value) {
+    char* end = nullptr;
+    errno = 0;
+    long long parsed = std::strtoll(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+static uint64_t splitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Per-case generator, seeded from (fuzz seed, stream, case index)
+struct CaseRandom {
+    uint64_t state;
+    CaseRandom(uint64_t fuzzSeed, uint64_t stream, int64_t index)
+        : state(splitMix64(fuzzSeed ^ splitMix64(stream * 0x632BE59BD9B4E019ULL + (uint64_t)index))) {}
+    uint64_t next() { return state = splitMix64(state); }
+    int64_t range(int64_t lo, int64_t hi) { return lo + (int64_t)(next() % (uint64_t)(hi - lo)); }   // [lo, hi)
+};
+
+// First mismatch by case index, so the report doesn't depend on thread timing
+struct MismatchReport {
+    std::mutex mutex;
+    std::atomic<int64_t> firstIndex{INT64_MAX};
+    std::string text;
+
+    void record(int64_t index, const std::string& description) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (index < firstIndex.load(std::memory_order_relaxed)) {
+            firstIndex.store(index, std::memory_order_relaxed);
+            text = description;
+        }
+    }
+    bool found() const { return firstIndex.load(std::memory_order_relaxed) != INT64_MAX; }
+};
+
+// KERNEL CASES
+// A row of chunks [startX, startX + count) at chunkZ for one world seed. Rows come from
+// six coordinate classes: around the origin (negative included), anywhere inside the
+// world border, around +-INT32_MAX/16, straddling the int32 wrap in X, anywhere in int32
+// and anywhere in int64 (the kernels truncate to int32 like Java does).
+struct KernelRow {
+    int64_t worldSeed;
+    int64_t startX, chunkZ, count;
+    int64_t extraSeeds[2];     // Other seeds sharing the row in the multi-seed fill
+    const char* className;
+};
+
+static KernelRow makeKernelRow(uint64_t fuzzSeed, int64_t index) {
+    const int64_t WORLD_BORDER_CHUNKS = 1875000;
+    const int64_t BLOCK_LIMIT_CHUNKS = INT32_MAX / 16;
+    CaseRandom random(fuzzSeed, 1, index);
+
+    KernelRow row;
+    row.worldSeed = (random.next() & 3) ? (int64_t)random.next() : random.range(-100000, 100000);
+    row.extraSeeds[0] = (int64_t)random.next();
+    row.extraSeeds[1] = row.worldSeed ^ (int64_t)(random.next() & 0xFFFFFFFFULL);
+    row.count = (random.next() & 7) ? random.range(1, 1024) : random.range(1024, 8192);
+
+    switch (index % 6) {
+        case 0:
+            row.className = "origin";
+            row.startX = random.range(-8192, 8192);
+            row.chunkZ = random.range(-8192, 8192);
+            break;
+        case 1:
+            row.className = "world";
+            row.startX = random.range(-WORLD_BORDER_CHUNKS, WORLD_BORDER_CHUNKS);
+            row.chunkZ = random.range(-WORLD_BORDER_CHUNKS, WORLD_BORDER_CHUNKS);
+            break;
+        case 2:
+            row.className = "int32/16";
+            row.startX = ((random.next() & 1) ? BLOCK_LIMIT_CHUNKS : -BLOCK_LIMIT_CHUNKS) + random.range(-8192, 8192);
+            row.chunkZ = ((random.next() & 1) ? BLOCK_LIMIT_CHUNKS : -BLOCK_LIMIT_CHUNKS) + random.range(-8192, 8192);
+            break;
+        case 3:
+            row.className = "int32 wrap";
+            row.startX = ((random.next() & 1) ? 2147483648LL : -2147483648LL) - random.range(0, row.count + 1);
+            row.chunkZ = ((random.next() & 1) ? INT32_MAX : INT32_MIN) + random.range(-64, 64);
+            break;
+        case 4:
+            row.className = "int32";
+            row.startX = (int32_t)random.next();
+            row.chunkZ = (int32_t)random.next();
+            break;
+        default:
+            row.className = "int64";
+            row.startX = (int64_t)(random.next() >> 1) - (INT64_MAX / 2);
+            row.chunkZ = (int64_t)(random.next() >> 1) - (INT64_MAX / 2);
+            break;
+    }
+    return row;
+}
+
+static std::string describeRow(uint64_t fuzzSeed, int64_t index, const KernelRow& row) {
+    std::ostringstream out;
+    out << "row " << index << " (" << row.className << "): seed " << row.worldSeed << ", x [" << row.startX
+        << ", " << row.startX + row.count << "), z " << row.chunkZ << "\n"
+        << "  rerun: fuzz_differential --seed " << fuzzSeed << " --row " << index << "\n";
+    return out.str();
+}
+
+// Compare a filled row against the reference. Bits past count must be clear.
+static bool checkRowBits(const std::vector<uint64_t>& expected, const std::vector<uint64_t>& got,
+                         const KernelRow& row, int64_t worldSeed, const std::string& fill, std::string& description) {
+    for (size_t w = 0; w < expected.size(); w++) {
+        if (expected[w] == got[w]) continue;
+        uint64_t diff = expected[w] ^ got[w];
+        int64_t bit = (int64_t)w * 64;
+        while (!((diff >> (bit & 63)) & 1)) bit++;
+        std::ostringstream out;
+        out << fill << " disagrees with isSlimeChunk at chunk (" << row.startX + bit << ", " << row.chunkZ
+            << "), seed " << worldSeed << ", offset " << bit << ": expected " << ((expected[w] >> (bit & 63)) & 1)
+            << ", got " << ((got[w] >> (bit & 63)) & 1) << (bit >= row.count ? " (past count)" : "") << "\n";
+        description = out.str();
+        return false;
+    }
+    return true;
+}
+
+static void referenceRow(const KernelRow& row, int64_t worldSeed, std::vector<uint64_t>& bits) {
+    bits.assign((size_t)((row.count + 63) / 64), 0);
+    for (int64_t i = 0; i < row.count; i++) {
+        if (isSlimeChunk(row.startX + i, row.chunkZ, worldSeed)) {
+            bits[i >> 6] |= 1ULL << (i & 63);
+        }
+    }
+}
+
+// Every fill of every supported kernel, plus the point checks on scattered coordinates.
+// description is set on a mismatch.
+static bool checkKernelRow(const KernelRow& row, SimdLevel simdLevel, std::string& description) {
+    std::vector<uint64_t> expected;
+    std::vector<uint64_t> got;
+    referenceRow(row, row.worldSeed, expected);
+
+    std::vector<uint64_t> extraExpected[2];
+    std::vector<uint64_t> multiRows[3];
+    const int64_t seeds[3] = {row.worldSeed, row.extraSeeds[0], row.extraSeeds[1]};
+    referenceRow(row, seeds[1], extraExpected[0]);
+    referenceRow(row, seeds[2], extraExpected[1]);
+
+    for (int level = 0; level <= (int)simdLevel; level++) {
+        const SlimeKernel& kernel = slimeKernelFor((SimdLevel)level);
+        std::string name = simdLevelName((SimdLevel)level);
+
+        got.assign(expected.size(), ~0ULL);
+        kernel.fillRowBatch(row.startX, row.chunkZ, row.count, row.worldSeed, got.data());
+        if (!checkRowBits(expected, got, row, row.worldSeed, name + " fillRowBatch", description)) return false;
+
+        got.assign(expected.size(), ~0ULL);
+        kernel.fillRowIncremental(row.startX, row.chunkZ, row.count, row.worldSeed, got.data());
+        if (!checkRowBits(expected, got, row, row.worldSeed, name + " fillRowIncremental", description)) return false;
+
+        uint64_t* rowPtrs[3];
+        for (int k = 0; k < 3; k++) {
+            multiRows[k].assign(expected.size(), ~0ULL);
+            rowPtrs[k] = multiRows[k].data();
+        }
+        kernel.fillRowMultiSeed(row.startX, row.chunkZ, row.count, seeds, 3, rowPtrs);
+        if (!checkRowBits(expected, multiRows[0], row, seeds[0], name + " fillRowMultiSeed", description) ||
+            !checkRowBits(extraExpected[0], multiRows[1], row, seeds[1], name + " fillRowMultiSeed", description) ||
+            !checkRowBits(extraExpected[1], multiRows[2], row, seeds[2], name + " fillRowMultiSeed", description)) {
+            return false;
+        }
+    }
+
+    // Point checks: 16 coordinates from around the row, in no particular order
+    alignas(64) int64_t chunkX[16];
+    alignas(64) int64_t chunkZ[16];
+    uint64_t scatter = splitMix64((uint64_t)row.startX ^ (uint64_t)row.chunkZ);
+    for (int i = 0; i < 16; i++) {
+        scatter = splitMix64(scatter);
+        chunkX[i] = row.startX + (int64_t)(scatter % (uint64_t)row.count);
+        chunkZ[i] = row.chunkZ + (int64_t)((scatter >> 32) % 64) - 32;
+    }
+    auto checkMask = [&](uint32_t mask, int lanes, const char* fill) {
+        for (int i = 0; i < lanes; i++) {
+            bool expectedBit = isSlimeChunk(chunkX[i], chunkZ[i], row.worldSeed);
+            if (((mask >> i) & 1) != (uint32_t)expectedBit) {
+                std::ostringstream out;
+                out << fill << " disagrees with isSlimeChunk at chunk (" << chunkX[i] << ", " << chunkZ[i]
+                    << "), seed " << row.worldSeed << ", lane " << i << ": expected " << expectedBit << "\n";
+                description = out.str();
+                return false;
+            }
+        }
+        return true;
+    };
+    if (simdLevel >= SimdLevel::AVX512 &&
+        !checkMask(isSlimeChunkVec16(chunkX, chunkZ, row.worldSeed), 16, "isSlimeChunkVec16")) {
+        return false;
+    }
+    if (simdLevel >= SimdLevel::AVX2 &&
+        !checkMask(isSlimeChunkVec8(chunkX, chunkZ, row.worldSeed), 8, "isSlimeChunkVec8")) {
+        return false;
+    }
+    return true;
+}
+
+// RECTANGLE CASES
+// A random grid of up to 64 x 200 (so rows straddle word boundaries), a random density,
+// planted all-slime blocks, a minimum dimension and area, and chunk offsets on either
+// side of zero.
+struct GridCase {
+    int64_t rows, cols, densityPerMille, plantedBlocks, maxBlockSide;
+    int64_t n, minimumArea;
+    int64_t offsetX, offsetZ;
+};
+
+static GridCase makeGridCase(uint64_t fuzzSeed, int64_t index) {
+    CaseRandom random(fuzzSeed, 2, index);
+    GridCase gc;
+    gc.rows = random.range(1, 65);
+    gc.cols = random.range(1, 201);
+    const int64_t densities[] = {50, 100, 300, 500, 800, 950};
+    gc.densityPerMille = densities[random.next() % 6];
+    gc.plantedBlocks = random.range(0, 8);
+    gc.maxBlockSide = random.range(1, 24);
+    gc.n = random.range(1, 7);
+    gc.minimumArea = (random.next() & 3) ? 0 : gc.n * random.range(gc.n, 3 * gc.n);
+    gc.offsetX = random.range(-2000000, 2000000);
+    gc.offsetZ = random.range(-2000000, 2000000);
+    return gc;
+}
+
+static void fillGrid(SlimeGrid& grid, uint64_t fuzzSeed, int64_t index, const GridCase& gc) {
+    CaseRandom random(fuzzSeed, 3, index);
+    for (int64_t r = 0; r < grid.rows; r++) {
+        for (int64_t c = 0; c < grid.cols; c++) {
+            if ((int64_t)(random.next() % 1000) < gc.densityPerMille) grid.set(r, c);
+        }
+    }
+    for (int64_t b = 0; b < gc.plantedBlocks; b++) {
+        int64_t h = random.range(1, gc.maxBlockSide + 1);
+        int64_t w = random.range(1, gc.maxBlockSide + 1);
+        int64_t r0 = random.range(0, grid.rows);
+        int64_t c0 = random.range(0, grid.cols);
+        for (int64_t r = r0; r < std::min(grid.rows, r0 + h); r++) {
+            for (int64_t c = c0; c < std::min(grid.cols, c0 + w); c++) {
+                grid.set(r, c);
+            }
+        }
+    }
+}
+
+// (x, z, width, height) in grid coordinates
+typedef std::tuple<int64_t, int64_t, int64_t, int64_t> RectKey;
+
+// Maximal oracle: every all-slime rectangle of at least n x n and minimumArea that
+// cannot grow by a row or column in any direction
+static std::set<RectKey> bruteForceMaximal(const SlimeGrid& grid, int64_t n, int64_t minimumArea) {
+    int64_t rows = grid.rows, cols = grid.cols;
+    std::vector<int64_t> prefix((rows + 1) * (cols + 1), 0);
+    for (int64_t r = 0; r < rows; r++) {
+        for (int64_t c = 0; c < cols; c++) {
+            prefix[(r + 1) * (cols + 1) + c + 1] = grid.get(r, c) + prefix[r * (cols + 1) + c + 1] +
+                                                    prefix[(r + 1) * (cols + 1) + c] - prefix[r * (cols + 1) + c];
+        }
+    }
+    auto allSlime = [&](int64_t r0, int64_t c0, int64_t r1, int64_t c1) {
+        if (r0 < 0 || c0 < 0 || r1 >= rows || c1 >= cols) return false;
+        int64_t sum = prefix[(r1 + 1) * (cols + 1) + c1 + 1] - prefix[r0 * (cols + 1) + c1 + 1] -
+                      prefix[(r1 + 1) * (cols + 1) + c0] + prefix[r0 * (cols + 1) + c0];
+        return sum == (r1 - r0 + 1) * (c1 - c0 + 1);
+    };
+
+    std::set<RectKey> result;
+    for (int64_t r0 = 0; r0 < rows; r0++) {
+        for (int64_t c0 = 0; c0 < cols; c0++) {
+            for (int64_t r1 = r0 + n - 1; r1 < rows; r1++) {
+                if (!allSlime(r0, c0, r1, c0)) break;
+                for (int64_t c1 = c0 + n - 1; c1 < cols; c1++) {
+                    if (!allSlime(r0, c0, r1, c1)) break;
+                    if ((r1 - r0 + 1) * (c1 - c0 + 1) < minimumArea) continue;
+                    if (allSlime(r0 - 1, c0, r1, c1) || allSlime(r0, c0, r1 + 1, c1) ||
+                        allSlime(r0, c0 - 1, r1, c1) || allSlime(r0, c0, r1, c1 + 1)) {
+                        continue;
+                    }
+                    result.insert(RectKey(c0, r0, c1 - c0 + 1, r1 - r0 + 1));
+                }
+            }
+        }
+    }
+    return result;
+}
+
+// Exhaustive oracle: for every row and column span, the tallest all-slime rectangle
+// ending on that row, if it meets the minimum size and area
+static std::set<RectKey> bruteForceExhaustive(const SlimeGrid& grid, int64_t n, int64_t minimumArea) {
+    std::vector<int64_t> heights((size_t)grid.cols, 0);
+    std::set<RectKey> result;
+    for (int64_t r = 0; r < grid.rows; r++) {
+        for (int64_t c = 0; c < grid.cols; c++) {
+            heights[c] = grid.get(r, c) ? heights[c] + 1 : 0;
+        }
+        for (int64_t i = 0; i < grid.cols; i++) {
+            int64_t minHeight = INT64_MAX;
+            for (int64_t j = i; j < grid.cols && heights[j] > 0; j++) {
+                minHeight = std::min(minHeight, heights[j]);
+                int64_t width = j - i + 1;
+                if (width >= n && minHeight >= n && width * minHeight >= minimumArea) {
+                    result.insert(RectKey(i, r - minHeight + 1, width, minHeight));
+                }
+            }
+        }
+    }
+    return result;
+}
+
+static std::string describeGrid(uint64_t fuzzSeed, int64_t index, const GridCase& gc) {
+    std::ostringstream out;
+    out << "grid " << index << ": " << gc.rows << "x" << gc.cols << ", density " << gc.densityPerMille
+        << "/1000, " << gc.plantedBlocks << " blocks, n " << gc.n << ", minimum area " << gc.minimumArea
+        << ", offset (" << gc.offsetX << ", " << gc.offsetZ << ")\n"
+        << "  rerun: fuzz_differential --seed " << fuzzSeed << " --grid " << index << "\n";
+    return out.str();
+}
+
+// Compare one engine's output (in chunk coordinates) against an oracle
+static bool checkRectangles(const std::set<RectKey>& expected, const std::vector<Rectangle>& found,
+                            const GridCase& gc, const std::string& engine, std::string& description) {
+    std::set<RectKey> actual;
+    for (const Rectangle& rect : found) {
+        actual.insert(RectKey(rect.x - gc.offsetX, rect.z - gc.offsetZ, rect.width, rect.height));
+    }
+    if (actual == expected && actual.size() == found.size()) {
+        return true;
+    }
+    std::ostringstream out;
+    out << engine << ": found " << found.size() << " (" << actual.size() << " distinct), expected "
+        << expected.size() << "\n";
+    auto show = [&](const char* what, const RectKey& key) {
+        out << "  " << what << " " << std::get<2>(key) << "x" << std::get<3>(key) << " at grid ("
+            << std::get<0>(key) << ", " << std::get<1>(key) << ")\n";
+    };
+    for (const RectKey& key : expected) {
+        if (!actual.count(key)) { show("missing", key); break; }
+    }
+    for (const RectKey& key : actual) {
+        if (!expected.count(key)) { show("extra", key); break; }
+    }
+    if (actual.size() != found.size()) {
+        out << "  duplicates reported\n";
+    }
+    description = out.str();
+    return false;
+}
+
+// Every rectangle engine: maximal and exhaustive scans with each height kernel, and the
+// square filter's bands in both modes
+static bool checkGridCase(const SlimeGrid& grid, const GridCase& gc, SimdLevel simdLevel, std::string& description) {
+    std::set<RectKey> maximal = bruteForceMaximal(grid, gc.n, gc.minimumArea);
+    std::set<RectKey> exhaustive = bruteForceExhaustive(grid, gc.n, gc.minimumArea);
+
+    for (int level = 0; level <= (int)simdLevel; level++) {
+        for (RectMode mode : {RectMode::Maximal, RectMode::Exhaustive}) {
+            const std::set<RectKey>& expected = (mode == RectMode::Maximal) ? maximal : exhaustive;
+            std::string engine = std::string(rectModeName(mode)) + "/" + simdLevelName((SimdLevel)level);
+
+            std::vector<Rectangle> found;
+            findMaximalRectangles(grid, 0, grid.rows, gc.offsetX, gc.offsetZ, gc.n, found, mode, gc.minimumArea,
+                                  false, (SimdLevel)level);
+            if (!checkRectangles(expected, found, gc, engine + " full scan", description)) return false;
+
+            std::vector<std::pair<int64_t, int64_t>> bands;
+            bool anyBand = findSquareCandidateBands(grid, gc.n, bands);
+            found.clear();
+            for (const auto& band : bands) {
+                findMaximalRectangles(grid, band.first, band.second, gc.offsetX, gc.offsetZ, gc.n, found, mode,
+                                      gc.minimumArea, false, (SimdLevel)level);
+            }
+            if (!checkRectangles(expected, found, gc, engine + " square filter", description)) return false;
+            // With a minimum area the filter may keep bands whose squares are all too small
+            if (!anyBand && !expected.empty()) {
+                description = engine + " square filter: no band, but rectangles exist\n";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void dumpGrid(const SlimeGrid& grid, const std::string& path) {
+    std::ofstream out(path);
+    for (int64_t r = 0; r < grid.rows; r++) {
+        for (int64_t c = 0; c < grid.cols; c++) {
+            out << (grid.get(r, c) ? '#' : '.');
+        }
+        out << '\n';
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int64_t fuzzSeed = 1;
+    int64_t chunkTarget = 256LL << 20;
+    int64_t gridCount = 4000;
+    int64_t numThreads = std::max<int64_t>(1, std::thread::hardware_concurrency());
+    int64_t onlyRow = -1, onlyGrid = -1;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        int64_t* target = nullptr;
+        if (arg == "--seed") target = &fuzzSeed;
+        else if (arg == "--chunks") target = &chunkTarget;
+        else if (arg == "--grids") target = &gridCount;
+        else if (arg == "--threads") target = &numThreads;
+        else if (arg == "--row") target = &onlyRow;
+        else if (arg == "--grid") target = &onlyGrid;
+        if (target == nullptr || i + 1 >= argc || !parseInt64Arg(argv[i + 1], *target)) {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--seed S] [--chunks N] [--grids N] [--threads N] [--row I | --grid I]\n";
+            return 2;
+        }
+        i++;
+    }
+    numThreads = std::max<int64_t>(1, numThreads);
+
+    SimdLevel simdLevel = detectSimdLevel();
+    std::cout << "Differential fuzzer, seed " << fuzzSeed << ", kernels up to " << simdLevelName(simdLevel)
+              << ", " << numThreads << " threads\n";
+
+    // Single case reruns
+    if (onlyRow >= 0 || onlyGrid >= 0) {
+        std::string description;
+        bool passed;
+        if (onlyRow >= 0) {
+            KernelRow row = makeKernelRow((uint64_t)fuzzSeed, onlyRow);
+            std::cout << describeRow((uint64_t)fuzzSeed, onlyRow, row);
+            passed = checkKernelRow(row, simdLevel, description);
+        } else {
+            GridCase gc = makeGridCase((uint64_t)fuzzSeed, onlyGrid);
+            SlimeGrid grid(gc.rows, gc.cols);
+            fillGrid(grid, (uint64_t)fuzzSeed, onlyGrid, gc);
+            std::cout << describeGrid((uint64_t)fuzzSeed, onlyGrid, gc);
+            dumpGrid(grid, "fuzz_grid.txt");
+            std::cout << "  grid written to fuzz_grid.txt\n";
+            passed = checkGridCase(grid, gc, simdLevel, description);
+        }
+        std::cout << (passed ? "[PASS]\n" : "[FAIL] " + description);
+        return passed ? 0 : 1;
+    }
+
+    // Kernels: rows are claimed in blocks until the chunk target is reached
+    const int64_t ROW_BLOCK = 64;
+    std::atomic<int64_t> nextRow{0};
+    std::atomic<int64_t> chunksChecked{0};
+    MismatchReport kernelMismatch;
+    auto kernelStart = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int64_t t = 0; t < numThreads; t++) {
+        threads.emplace_back([&]() {
+            std::string description;
+            while (chunksChecked.load(std::memory_order_relaxed) < chunkTarget) {
+                int64_t first = nextRow.fetch_add(ROW_BLOCK);
+                if (first > kernelMismatch.firstIndex.load(std::memory_order_relaxed)) return;
+                int64_t chunks = 0;
+                for (int64_t index = first; index < first + ROW_BLOCK; index++) {
+                    KernelRow row = makeKernelRow((uint64_t)fuzzSeed, index);
+                    if (!checkKernelRow(row, simdLevel, description)) {
+                        kernelMismatch.record(index, describeRow((uint64_t)fuzzSeed, index, row) + "  " + description);
+                        break;
+                    }
+                    chunks += row.count;
+                }
+                chunksChecked.fetch_add(chunks, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+    double kernelSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - kernelStart).count();
+    std::cout << "Kernels: " << nextRow.load() << " rows, " << chunksChecked.load() << " chunks per fill in "
+              << kernelSeconds << " s (" << (chunksChecked.load() / kernelSeconds / 1e6) << " M chunks/s)\n";
+
+    // Rectangle engines
+    std::atomic<int64_t> nextGrid{0};
+    MismatchReport gridMismatch;
+    auto gridStart = std::chrono::steady_clock::now();
+    for (int64_t t = 0; t < numThreads; t++) {
+        threads.emplace_back([&]() {
+            std::string description;
+            SlimeGrid grid;
+            for (int64_t index = nextGrid.fetch_add(1); index < gridCount; index = nextGrid.fetch_add(1)) {
+                if (index > gridMismatch.firstIndex.load(std::memory_order_relaxed)) return;
+                GridCase gc = makeGridCase((uint64_t)fuzzSeed, index);
+                grid.resize(gc.rows, gc.cols);
+                fillGrid(grid, (uint64_t)fuzzSeed, index, gc);
+                if (!checkGridCase(grid, gc, simdLevel, description)) {
+                    gridMismatch.record(index, describeGrid((uint64_t)fuzzSeed, index, gc) + "  " + description);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double gridSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - gridStart).count();
+    std::cout << "Rectangles: " << std::min(gridCount, nextGrid.load()) << " grids in " << gridSeconds << " s\n";
+
+    if (kernelMismatch.found()) {
+        std::cout << "\n[FAIL] First kernel mismatch, " << kernelMismatch.text;
+    }
+    if (gridMismatch.found()) {
+        std::cout << "\n[FAIL] First rectangle mismatch, " << gridMismatch.text;
+    }
+    if (kernelMismatch.found() || gridMismatch.found()) {
+        return 1;
+    }
+    std::cout << "[PASS] Every kernel and rectangle engine matches the reference\n";
+    return 0;
+}
@@ -4,6 +4,9 @@
 #include <chrono>
 #include <csignal>
 #include <iomanip>
+#include <cstdlib>
+#include <algorithm>
+#include <cerrno>
 
 // SIGNAL HANDLING
 std::atomic<bool>* g_pauseFlag = nullptr;
@@ -14,82 +17,669 @@ void signalHandler(int signal) {
     }
 }
 
+// ARGUMENT PARSING
+// Whole-argument decimal integer; trailing text or overflow is rejected
+static bool parseInt64Arg(const char* text, int64_t& value) {
+    char* end = nullptr;
+    errno = 0;
+    long long parsed = std::strtoll(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+// Comma-separated list of integers, e.g. "1,-2,3"
+static bool parseInt64ListArg(const char* text, std::vector<int64_t>& values) {
+    values.clear();
+    std::string list = text;
+    size_t start = 0;
+    while (true) {
+        size_t comma = list.find(',', start);
+        std::string item = list.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+        int64_t value;
+        if (!parseInt64Arg(item.c_str(), value)) {
+            return false;
+        }
+        values.push_back(value);
+        if (comma == std::string::npos) {
+            return true;
+        }
+        start = comma + 1;
+    }
+}
+
+// SEED SWEEP
+// Fixed region, world seeds [seedStart, seedEnd) spread over the threads. Bounds are in
+// blocks and already validated.
+static int runSeedSweep(int64_t seedStart, int64_t seedEnd,
+                        int64_t searchMinX, int64_t searchMaxX, int64_t searchMinZ, int64_t searchMaxZ,
+                        int64_t minimumRectDimension, int64_t numThreads, int64_t topK,
+                        const EngineConfig& engines,
+                        const std::string& checkpointPath, const std::string& resumePath) {
+    int64_t minX = searchMinX / 16;
+    int64_t maxX = searchMaxX / 16;
+    int64_t minZ = searchMinZ / 16;
+    int64_t maxZ = searchMaxZ / 16;
+
+    SeedSweepCheckpoint sweepIdentity;
+    sweepIdentity.seedStart = seedStart;
+    sweepIdentity.seedEnd = seedEnd;
+    sweepIdentity.searchMinX = searchMinX;
+    sweepIdentity.searchMaxX = searchMaxX;
+    sweepIdentity.searchMinZ = searchMinZ;
+    sweepIdentity.searchMaxZ = searchMaxZ;
+    sweepIdentity.minimumRectDimension = minimumRectDimension;
+
+    SeedResultStore results(topK);
+    std::atomic<bool> pauseFlag{false};
+    std::atomic<int64_t> seedsProcessed{0};
+    int64_t completedBlocks = 0;
+    if (!resumePath.empty()) {
+        SeedSweepCheckpoint saved;
+        if (!loadSeedSweepCheckpoint(resumePath, saved)) {
+            return 1;
+        }
+        if (!saved.sameSweep(sweepIdentity)) {
+            std::cerr << "Checkpoint " << resumePath << " was written for a different sweep"
+                      << " (seed range, bounds or dimension)\n";
+            return 1;
+        }
+        completedBlocks = saved.completedBlocks;
+        seedsProcessed = saved.seedsProcessed;
+        results.insertBatch(saved.results);
+    }
+    SeedSweepQueue queue(seedStart, seedEnd, completedBlocks);
+
+    g_pauseFlag = &pauseFlag;
+    signal(SIGINT, signalHandler);
+
+    std::cout << "Minecraft Slime Chunk Seed Sweep\n";
+    std::cout << "==========================================================\n";
+    std::cout << "Seeds: [" << seedStart << ", " << seedEnd << ") in blocks of " << SEED_SWEEP_BLOCK_SIZE
+              << ", " << seedSweepPassSeeds(maxX - minX, maxZ - minZ) << " per pass\n";
+    std::cout << "Region (chunks): X[" << minX << " to " << maxX << "] Z[" << minZ << " to " << maxZ << "]\n";
+    std::cout << "Min Rectangle Dimension: " << minimumRectDimension << "x" << minimumRectDimension << "\n";
+    std::cout << "Worker Threads: " << numThreads << "\n";
+    std::cout << "SIMD: " << slimeKernelFor(engines.simdLevel).name << "\n";
+    std::cout << "Result Bound: best " << topK << " seeds\n";
+    std::cout << "Checkpoint: " << checkpointPath << " (every " << CHECKPOINT_INTERVAL_SECONDS << "s)\n";
+    if (completedBlocks > 0) {
+        std::cout << "Resumed from " << resumePath << ": " << completedBlocks << " blocks done, "
+                  << results.size() << " seeds kept\n";
+    }
+    std::cout << "Press Ctrl+C to pause and view stats\n\n";
+
+    // The watermark is read before the results and a block is only marked once its seeds
+    // are in the store, so every block below it has its seeds in the file
+    auto writeCheckpoint = [&]() {
+        SeedSweepCheckpoint checkpoint = sweepIdentity;
+        checkpoint.completedBlocks = queue.completedBlocks();
+        checkpoint.seedsProcessed = std::min(seedEnd - seedStart, checkpoint.completedBlocks * SEED_SWEEP_BLOCK_SIZE);
+        checkpoint.results = results.snapshot();
+        return saveSeedSweepCheckpoint(checkpointPath, checkpoint);
+    };
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    int64_t resumedSeeds = seedsProcessed.load();
+
+    std::vector<std::thread> threads;
+    for (int64_t i = 0; i < numThreads; i++) {
+        threads.emplace_back(seedSweepThread, i, minX, maxX, minZ, maxZ, minimumRectDimension,
+                             std::ref(queue), std::ref(results), std::ref(pauseFlag),
+                             std::ref(seedsProcessed), std::cref(engines));
+    }
+
+    std::thread monitor([&]() {
+        int64_t totalSeeds = seedEnd - seedStart;
+        auto lastCheckpoint = std::chrono::steady_clock::now();
+        while (!pauseFlag) {
+            std::this_thread::sleep_for(std::chrono::seconds(5));
+            if (!pauseFlag) {
+                int64_t processed = seedsProcessed.load();
+                std::cout << "[Progress] " << std::fixed << std::setprecision(4)
+                          << (100.0 * processed / totalSeeds) << "% "
+                          << "(" << processed << "/" << totalSeeds << " seeds) | "
+                          << "Kept: " << results.size() << " | Admission area: " << results.admissionArea()
+                          << "    \r" << std::flush;
+                printSeedSweepStats(processed, results, true);
+
+                auto now = std::chrono::steady_clock::now();
+                if (now - lastCheckpoint >= std::chrono::seconds(CHECKPOINT_INTERVAL_SECONDS)) {
+                    writeCheckpoint();
+                    lastCheckpoint = now;
+                }
+            }
+        }
+    });
+
+    for (auto& t : threads) {
+        t.join();
+    }
+    pauseFlag = true;
+    monitor.join();
+
+    if (writeCheckpoint()) {
+        std::cout << "\nCheckpoint saved to " << checkpointPath;
+        if (queue.completedBlocks() < queue.blockCount()) {
+            std::cout << " (resume with --resume " << checkpointPath << ")";
+        }
+        std::cout << "\n";
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+
+    printSeedSweepStats(seedsProcessed.load(), results, true);
+    printSeedSweepStats(seedsProcessed.load(), results);
+
+    std::cout << "Total time: " << duration.count() / 1000.0 << " seconds\n";
+    std::cout << "Throughput: " << ((seedsProcessed.load() - resumedSeeds) * 1000.0 / duration.count())
+              << " seeds/sec\n";
+
+    g_pauseFlag = nullptr;
+    return 0;
+}
+
 // MAIN
 int main(int argc, char* argv[]) {
-    // Configuration
-    const int64_t WORLD_SEED = 413563856LL;
-    const int64_t MINIMUM_RECT_DIMENSION = 3;
+    // Configuration, all overridable from the command line
+    int64_t worldSeed = 413563856LL;
+    std::vector<int64_t> worldSeeds;     // --seeds; empty searches worldSeed alone
+    int64_t minimumRectDimension = 3;
+    int64_t workUnitSize = WORK_UNIT_SIZE;
+    int64_t numThreads = 0;              // 0: one per logical core
+    int64_t sweepStart = 0;              // Seed sweep over [sweepStart, sweepEnd), see runSeedSweep
+    int64_t sweepEnd = -1;
+    int64_t radius = 0;                  // Chunks; nonzero replaces the bounds with [-radius, radius)
 
-    // Search bounds (in blocks) - can be overridden via command line
+    // Search bounds (in blocks)
     int64_t searchMinX = -30000000;
     int64_t searchMaxX = 30000000;
     int64_t searchMinZ = -30000000;
     int64_t searchMaxZ = 30000000;
 
-    // State variables
-    std::mutex resultsMutex;
-    std::set<Rectangle> foundRectangles;
+    // Engine selection and result bound
+    EngineConfig engines;
+    SimdLevel detectedSimd = detectSimdLevel();
+    engines.simdLevel = detectedSimd;
+    int64_t topK = 0;
+    std::string checkpointPath = "slimechunkfinder.ckpt";
+    std::string resumePath;
+    std::string bitmapCachePath;
+    std::string metricsPath;
+    bool pinWorkers = true;              // --affinity numa: one CPU per worker, node by node
+    bool checkpointPathSet = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        
+        // Integer options
+        struct IntOption { const char* name; int64_t* value; };
+        const IntOption intOptions[] = {
+            {"--seed", &worldSeed},
+            {"--min-x", &searchMinX},
+            {"--max-x", &searchMaxX},
+            {"--min-z", &searchMinZ},
+            {"--max-z", &searchMaxZ},
+            {"--min-dim", &minimumRectDimension},
+            {"--unit-size", &workUnitSize},
+            {"--threads", &numThreads},
+            {"--top", &topK},
+            {"--sweep-start", &sweepStart},
+            {"--sweep-end", &sweepEnd},
+            {"--radius", &radius},
+        };
+        const IntOption* intOption = nullptr;
+        for (const IntOption& option : intOptions) {
+            if (arg == option.name) {
+                intOption = &option;
+            }
+        }
+        if (intOption != nullptr && i + 1 < argc) {
+            if (!parseInt64Arg(argv[++i], *intOption->value)) {
+                std::cerr << intOption->name << " expects an integer, got " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--seeds" && i + 1 < argc) {
+            if (!parseInt64ListArg(argv[++i], worldSeeds)) {
+                std::cerr << "--seeds expects comma-separated integers, got " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--simd" && i + 1 < argc) {
+            if (!parseSimdLevel(argv[++i], engines.simdLevel)) {
+                std::cerr << "Unknown SIMD level: " << argv[i] << " (expected avx512, avx2 or scalar)\n";
+                return 1;
+            }
+            if (engines.simdLevel > detectedSimd) {
+                std::cerr << "This CPU only supports SIMD level " << simdLevelName(detectedSimd) << "\n";
+                return 1;
+            }
+        } else if (arg == "--engine" && i + 1 < argc) {
+            if (!parseGridEngine(argv[++i], engines.gridEngine)) {
+                std::cerr << "Unknown grid engine: " << argv[i] << " (expected batch or row)\n";
+                return 1;
+            }
+        } else if (arg == "--filter" && i + 1 < argc) {
+            if (!parseRectFilter(argv[++i], engines.rectFilter)) {
+                std::cerr << "Unknown rectangle filter: " << argv[i] << " (expected square or none)\n";
+                return 1;
+            }
+        } else if (arg == "--rects" && i + 1 < argc) {
+            if (!parseRectMode(argv[++i], engines.rectMode)) {
+                std::cerr << "Unknown rectangle mode: " << argv[i] << " (expected maximal or all)\n";
+                return 1;
+            }
+        } else if (arg == "--tiling" && i + 1 < argc) {
+            if (!parseTiling(argv[++i], engines.tiling)) {
+                std::cerr << "Unknown tiling: " << argv[i] << " (expected seams or padded)\n";
+                return 1;
+            }
+        } else if (arg == "--search" && i + 1 < argc) {
+            if (!parseSearchMode(argv[++i], engines.searchMode)) {
+                std::cerr << "Unknown search mode: " << argv[i] << " (expected exhaustive or largest)\n";
+                return 1;
+            }
+        } else if (arg == "--scheduler" && i + 1 < argc) {
+            if (!parseScheduler(argv[++i], engines.scheduler)) {
+                std::cerr << "Unknown scheduler: " << argv[i] << " (expected stealing or shared)\n";
+                return 1;
+            }
+        } else if (arg == "--affinity" && i + 1 < argc) {
+            std::string affinity = argv[++i];
+            if (affinity != "numa" && affinity != "none") {
+                std::cerr << "Unknown affinity: " << affinity << " (expected numa or none)\n";
+                return 1;
+            }
+            pinWorkers = (affinity == "numa");
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            checkpointPath = argv[++i];
+            checkpointPathSet = true;
+        } else if (arg == "--resume" && i + 1 < argc) {
+            resumePath = argv[++i];
+        } else if (arg == "--bitmap-cache" && i + 1 < argc) {
+            bitmapCachePath = argv[++i];
+        } else if (arg == "--metrics" && i + 1 < argc) {
+            metricsPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            std::cerr << "Usage: " << argv[0] << " [--seed SEED | --seeds A,B,...] [--min-x X] [--max-x X] [--min-z Z] [--max-z Z]"
+                      << " [--min-dim N] [--unit-size CHUNKS] [--threads N]"
+                      << " [--simd avx512|avx2|scalar] [--engine batch|row]"
+                      << " [--filter square|none] [--rects maximal|all] [--tiling seams|padded]"
+                      << " [--search exhaustive|largest] [--top K]"
+                      << " [--scheduler stealing|shared] [--affinity numa|none]"
+                      << " [--checkpoint FILE] [--resume FILE] [--bitmap-cache FILE] [--metrics FILE]"
+                      << " [--sweep-start SEED --sweep-end SEED] [--radius CHUNKS]\n";
+            std::cerr << "Bounds are in blocks; the unit size and radius are in chunks.\n";
+            return 1;
+        }
+    }
+
+    if (worldSeeds.empty()) {
+        worldSeeds.push_back(worldSeed);
+    }
+    for (size_t k = 0; k < worldSeeds.size(); k++) {
+        if (std::find(worldSeeds.begin(), worldSeeds.begin() + k, worldSeeds[k]) != worldSeeds.begin() + k) {
+            std::cerr << "--seeds lists " << worldSeeds[k] << " twice\n";
+            return 1;
+        }
+    }
+    bool multiSeed = worldSeeds.size() > 1;
+    if (multiSeed) {
+        // Seam edges are tracked for one seed only
+        engines.tiling = Tiling::Padded;
+    }
+    if (radius < 0 || radius > 30000000 / 16) {
+        std::cerr << "--radius expects 0 to " << 30000000 / 16 << " chunks (the world border)\n";
+        return 1;
+    }
+    if (radius > 0) {
+        searchMinX = searchMinZ = -radius * 16;
+        searchMaxX = searchMaxZ = radius * 16;
+    }
+    if (searchMinX >= searchMaxX || searchMinZ >= searchMaxZ) {
+        std::cerr << "Search bounds are empty: X[" << searchMinX << " to " << searchMaxX
+                  << "] Z[" << searchMinZ << " to " << searchMaxZ << "]\n";
+        return 1;
+    }
+    if (minimumRectDimension < 1) {
+        std::cerr << "--min-dim expects at least 1\n";
+        return 1;
+    }
+    if (workUnitSize < MIN_WORK_UNIT_SIZE || workUnitSize > MAX_WORK_UNIT_SIZE) {
+        std::cerr << "--unit-size expects " << MIN_WORK_UNIT_SIZE << " to " << MAX_WORK_UNIT_SIZE << " chunks\n";
+        return 1;
+    }
+    if (numThreads < 0) {
+        std::cerr << "--threads expects a positive count (0 uses every logical core)\n";
+        return 1;
+    }
+    if (topK < 0) {
+        std::cerr << "--top expects a non-negative count (0 keeps every rectangle)\n";
+        return 1;
+    }
+
+    // Keep checkpointing into the file we resumed from unless told otherwise
+    if (!resumePath.empty() && !checkpointPathSet) {
+        checkpointPath = resumePath;
+    }
+
+    bool seedSweep = sweepEnd >= 0;
+    if (!bitmapCachePath.empty() && (seedSweep || multiSeed)) {
+        std::cerr << "--bitmap-cache holds a single seed's bits; it can't be combined with --seeds or a sweep\n";
+        return 1;
+    }
+    if (!metricsPath.empty() && seedSweep) {
+        std::cerr << "--metrics times the region search stages; it can't be combined with a sweep\n";
+        return 1;
+    }
+    if (seedSweep) {
+        if (sweepStart < 0 || sweepStart >= sweepEnd || sweepEnd > SEED_SPACE_SIZE) {
+            std::cerr << "--sweep-start/--sweep-end expect 0 <= start < end <= 2^48\n";
+            return 1;
+        }
+        // The whole region is one grid, and its heights are uint16_t
+        if (searchMaxX / 16 - searchMinX / 16 > MAX_WORK_UNIT_SIZE ||
+            searchMaxZ / 16 - searchMinZ / 16 > MAX_WORK_UNIT_SIZE) {
+            std::cerr << "A seed sweep region is at most " << MAX_WORK_UNIT_SIZE << " chunks on a side\n";
+            return 1;
+        }
+        // Each thread holds at least one seed's grid of the region
+        if (seedSweepPassSeeds(searchMaxX / 16 - searchMinX / 16, searchMaxZ / 16 - searchMinZ / 16) == 0) {
+            std::cerr << "A seed sweep region's grid must fit in " << (SEED_SWEEP_GRID_BUDGET >> 20)
+                      << " MiB per thread; shrink the bounds or --radius\n";
+            return 1;
+        }
+        if (!checkpointPathSet && resumePath.empty()) {
+            checkpointPath = "slimeseeds.ckpt";
+        }
+    }
+
+    // Never trust a kernel that disagrees with the scalar reference; step down instead
+    while (!verifySlimeKernel(slimeKernelFor(engines.simdLevel), worldSeeds[0])) {
+        std::cerr << "WARNING: " << slimeKernelFor(engines.simdLevel).name
+                  << " kernel failed self-check, falling back\n";
+        if (engines.simdLevel == SimdLevel::Scalar) {
+            return 1;
+        }
+        engines.simdLevel = (SimdLevel)((int)engines.simdLevel - 1);
+    }
+
+    if (seedSweep) {
+        int64_t sweepThreads = numThreads;
+        if (sweepThreads == 0) {
+            sweepThreads = std::thread::hardware_concurrency();
+            sweepThreads = (sweepThreads == 0) ? 8 : sweepThreads;
+        }
+        std::vector<WorkerPlacement> placement = planWorkerPlacement(sweepThreads, detectNumaNodes());
+        if (pinWorkers) {
+            engines.placement = &placement;
+        }
+        return runSeedSweep(sweepStart, sweepEnd, searchMinX, searchMaxX, searchMinZ, searchMaxZ,
+                            minimumRectDimension, sweepThreads, (topK > 0) ? topK : SEED_SWEEP_DEFAULT_TOP,
+                            engines, checkpointPath, resumePath);
+    }
+
+    // State variables, one result store per seed
+    std::vector<std::unique_ptr<RectangleStore>> results;
+    for (size_t k = 0; k < worldSeeds.size(); k++) {
+        results.push_back(std::make_unique<RectangleStore>(topK));
+    }
+    auto resultFileName = [&](size_t k, const char* extension) {
+        return (multiSeed ? "slimechunkfinder_" + std::to_string(worldSeeds[k]) : std::string("slimechunkfinder")) +
+               extension;
+    };
+
+    // Merged rectangles reach disk through an append-only log per store, fed by a lock-free
+    // handoff, so the monitor never copies a store. A resumed run appends to its log.
+    std::vector<std::unique_ptr<ResultHandoff>> handoffs;
+    std::vector<std::unique_ptr<ResultLog>> logs;
+    for (size_t k = 0; k < results.size(); k++) {
+        handoffs.push_back(std::make_unique<ResultHandoff>());
+        logs.push_back(std::make_unique<ResultLog>());
+        if (!logs[k]->open(resultFileName(k, ".log"), !resumePath.empty())) {
+            return 1;
+        }
+        // Checkpointed rectangles are logged again on resume; compaction drops the duplicates
+        results[k]->setHandoff(handoffs[k].get());
+    }
+    auto totalFound = [&]() {
+        int64_t total = 0;
+        for (const auto& store : results) {
+            total += store->size();
+        }
+        return total;
+    };
     std::atomic<bool> pauseFlag{false};
     std::atomic<int64_t> chunksProcessed{0};
     std::atomic<int64_t> maxDistanceReached{0};
-    std::vector<std::pair<std::pair<int64_t, int64_t>, std::pair<int64_t, int64_t>>> workQueue;
-    std::atomic<int64_t> workQueueIndex{0};
+    SpiralWorkQueue workQueue(searchMinX, searchMaxX, searchMinZ, searchMaxZ, workUnitSize);
+    WorkProgress progress(workQueue.size());
+    SeamTracker seams(workQueue, progress);
+    BitmapCache bitmapCache;
+    if (!bitmapCachePath.empty()) {
+        if (!bitmapCache.open(bitmapCachePath, worldSeeds[0], workQueue)) {
+            return 1;
+        }
+        engines.bitmapCache = &bitmapCache;
+    }
 
     // Set up signal handler
     g_pauseFlag = &pauseFlag;
     signal(SIGINT, signalHandler);
 
     // Detect number of logical cores
-    int64_t NUM_THREADS = std::thread::hardware_concurrency();
-    if (NUM_THREADS == 0) {
-        NUM_THREADS = 8;
+    int64_t coresDetected = std::thread::hardware_concurrency();
+    if (coresDetected == 0) {
+        coresDetected = 8;
+    }
+    if (numThreads == 0) {
+        numThreads = coresDetected;
     }
 
-    std::cout << "Minecraft Slime Chunk Rectangle Finder (AVX-512 Optimized)\n";
+    // Each worker pins itself to one CPU, filling a NUMA node before moving to the next,
+    // and steals from workers on its own node first
+    std::vector<std::vector<int>> numaNodes = detectNumaNodes();
+    std::vector<WorkerPlacement> placement =
+        planWorkerPlacement(numThreads, pinWorkers ? numaNodes : std::vector<std::vector<int>>());
+    if (pinWorkers) {
+        engines.placement = &placement;
+    }
+    if (engines.scheduler == Scheduler::Stealing) {
+        workQueue.enableStealing(placement);
+    }
+
+    std::cout << "Minecraft Slime Chunk Rectangle Finder (SIMD Optimized)\n";
     std::cout << "==========================================================\n";
-    std::cout << "World Seed: " << WORLD_SEED << "\n";
-    std::cout << "CPU Cores Detected: " << NUM_THREADS << "\n";
+    if (multiSeed) {
+        std::cout << "World Seeds: " << worldSeeds.size() << " (";
+        for (size_t k = 0; k < worldSeeds.size(); k++) {
+            std::cout << (k > 0 ? ", " : "") << worldSeeds[k];
+        }
+        std::cout << "), one pass over the coordinates\n";
+    } else {
+        std::cout << "World Seed: " << worldSeeds[0] << "\n";
+    }
+    std::cout << "CPU Cores Detected: " << coresDetected << "\n";
+    std::cout << "Worker Threads: " << numThreads;
+    if (pinWorkers) {
+        std::cout << ", pinned across " << numaNodes.size() << " NUMA node" << (numaNodes.size() == 1 ? "" : "s");
+    }
+    std::cout << "\n";
+    std::cout << "Scheduler: " << schedulerName(engines.scheduler) << "\n";
     std::cout << "Search Bounds (blocks): X[" << searchMinX << " to " << searchMaxX
               << "] Z[" << searchMinZ << " to " << searchMaxZ << "]\n";
     std::cout << "Search Bounds (chunks): X[" << (searchMinX/16) << " to " << (searchMaxX/16)
               << "] Z[" << (searchMinZ/16) << " to " << (searchMaxZ/16) << "]\n";
-    std::cout << "Work Unit Size: " << WORK_UNIT_SIZE << " chunks\n";
-    std::cout << "Min Rectangle Dimension: " << MINIMUM_RECT_DIMENSION << "x" << MINIMUM_RECT_DIMENSION << "\n";
-    std::cout << "SIMD: AVX-512 16-wide vectorization enabled\n";
+    std::cout << "Work Unit Size: " << workUnitSize << " chunks\n";
+    std::cout << "Min Rectangle Dimension: " << minimumRectDimension << "x" << minimumRectDimension << "\n";
+    std::cout << "SIMD: " << slimeKernelFor(engines.simdLevel).name
+              << " (CPU supports " << simdLevelName(detectedSimd) << ")\n";
+    std::cout << "Grid Engine: " << gridEngineName(engines.gridEngine) << "\n";
+    std::cout << "Rectangle Filter: " << rectFilterName(engines.rectFilter) << "\n";
+    std::cout << "Rectangle Mode: " << rectModeName(engines.rectMode) << "\n";
+    std::cout << "Tiling: " << tilingName(engines.seamTiling() ? Tiling::Seams : Tiling::Padded) << "\n";
+    std::cout << "Search Mode: " << searchModeName(engines.searchMode) << "\n";
+    if (topK > 0) {
+        std::cout << "Result Bound: best " << topK << " rectangles\n";
+    }
+    std::cout << "Checkpoint: " << checkpointPath << " (every " << CHECKPOINT_INTERVAL_SECONDS << "s)\n";
+    if (bitmapCache.isOpen()) {
+        std::cout << "Bitmap Cache: " << bitmapCachePath << " (" << bitmapCache.validTiles() << "/"
+                  << bitmapCache.tileCount() << " tiles valid)\n";
+    }
+    if (!metricsPath.empty()) {
+        std::cout << "Stage Metrics: " << metricsPath << "\n";
+    }
     std::cout << "Press Ctrl+C to pause and view stats\n\n";
 
-    // Generate work queue sorted by distance from origin
-    std::cout << "Generating work queue...\n";
-    generateWorkQueue(searchMinX, searchMaxX, searchMinZ, searchMaxZ, workQueue);
-    std::cout << "Work queue ready: " << workQueue.size() << " units\n\n";
+    // Units are generated lazily, closest rings first
+    std::cout << "Work units: " << workQueue.size() << "\n";
+
+    // Identity of this search; a resumed checkpoint has to match it
+    Checkpoint searchIdentity;
+    searchIdentity.worldSeeds = worldSeeds;
+    searchIdentity.searchMinX = searchMinX;
+    searchIdentity.searchMaxX = searchMaxX;
+    searchIdentity.searchMinZ = searchMinZ;
+    searchIdentity.searchMaxZ = searchMaxZ;
+    searchIdentity.minimumRectDimension = minimumRectDimension;
+    searchIdentity.workUnitSize = workUnitSize;
+    searchIdentity.rectMode = (int64_t)engines.rectMode;
+    searchIdentity.tiling = (int64_t)(engines.seamTiling() ? Tiling::Seams : Tiling::Padded);
+    searchIdentity.unitCount = workQueue.size();
+
+    if (!resumePath.empty()) {
+        Checkpoint saved;
+        if (!loadCheckpoint(resumePath, saved)) {
+            return 1;
+        }
+        if (!saved.sameSearch(searchIdentity) || !progress.loadWords(saved.completedUnits)) {
+            std::cerr << "Checkpoint " << resumePath << " was written for a different search"
+                      << " (seeds, bounds, dimension, unit size or rectangle mode)\n";
+            return 1;
+        }
+        chunksProcessed = saved.chunksProcessed;
+        maxDistanceReached = saved.maxDistanceReached;
+        for (size_t k = 0; k < results.size(); k++) {
+            results[k]->insertBatch(saved.rectangles[k], true);
+        }
+        std::cout << "Resumed from " << resumePath << ": " << progress.completedCount() << " units done, "
+                  << totalFound() << " rectangles\n";
+    }
+    std::cout << "\n";
+
+    // Compaction: the sorted report is rebuilt from the log, not from the stores
+    auto writeReports = [&](bool toFile) {
+        for (size_t k = 0; k < results.size(); k++) {
+            logs[k]->appendFrom(*handoffs[k]);
+            std::vector<Rectangle> report;
+            if (!compactResultLog(resultFileName(k, ".log"), topK, report)) {
+                continue;
+            }
+            if (!toFile && multiSeed) {
+                std::cout << "\nWorld Seed " << worldSeeds[k] << " (" << resultFileName(k, ".txt") << ")";
+            }
+            printStats(chunksProcessed, maxDistanceReached, report, topK, results[k]->admissionArea(),
+                       toFile, resultFileName(k, ".txt"));
+        }
+    };
+
+    // Completion bits are read before the results, and a unit is only marked after its
+    // rectangles were merged, so every unit in the file has its rectangles in the file.
+    // The chunk count is derived from the same bits for the same reason.
+    auto writeCheckpoint = [&]() {
+        Checkpoint checkpoint = searchIdentity;
+        checkpoint.completedUnits = progress.snapshotWords();
+        for (int64_t i = 0; i < workQueue.size(); i++) {
+            if ((checkpoint.completedUnits[i >> 6] >> (i & 63)) & 1) {
+                WorkUnit work = workQueue.unitAt(i);
+                checkpoint.chunksProcessed += (work.maxX - work.minX) * (work.maxZ - work.minZ);
+            }
+        }
+        checkpoint.maxDistanceReached = maxDistanceReached.load();
+        for (const auto& store : results) {
+            checkpoint.rectangles.push_back(store->snapshot());
+        }
+        return saveCheckpoint(checkpointPath, checkpoint);
+    };
+
+    // Per-stage timers, only when asked for; otherwise each timer is a branch on a null pointer
+    std::unique_ptr<StageMetrics> metrics;
+    if (!metricsPath.empty()) {
+        metrics = std::make_unique<StageMetrics>(numThreads);
+        engines.metrics = metrics.get();
+    }
 
     auto startTime = std::chrono::high_resolution_clock::now();
 
     std::vector<std::thread> threads;
-    for (int64_t i = 0; i < NUM_THREADS; i++) {
-        threads.emplace_back(workerThread, i, NUM_THREADS, WORLD_SEED, MINIMUM_RECT_DIMENSION,
-                           searchMinX, searchMaxX, searchMinZ, searchMaxZ,
-                           std::ref(resultsMutex), std::ref(foundRectangles),
-                           std::ref(pauseFlag), std::ref(chunksProcessed), std::ref(maxDistanceReached),
-                           std::ref(workQueue), std::ref(workQueueIndex), false);
+    for (int64_t i = 0; i < numThreads; i++) {
+        if (multiSeed) {
+            threads.emplace_back(multiSeedWorkerThread, i, std::cref(worldSeeds), minimumRectDimension,
+                               searchMinX, searchMaxX, searchMinZ, searchMaxZ,
+                               std::ref(results),
+                               std::ref(pauseFlag), std::ref(chunksProcessed), std::ref(maxDistanceReached),
+                               std::ref(workQueue), std::ref(progress),
+                               std::cref(engines), false);
+        } else {
+            threads.emplace_back(workerThread, i, numThreads, worldSeeds[0], minimumRectDimension,
+                               searchMinX, searchMaxX, searchMinZ, searchMaxZ,
+                               std::ref(*results[0]),
+                               std::ref(pauseFlag), std::ref(chunksProcessed), std::ref(maxDistanceReached),
+                               std::ref(workQueue), std::ref(progress), std::ref(seams),
+                               std::cref(engines), false);
+        }
     }
 
     // Monitor thread
     std::thread monitor([&]() {
         int64_t totalWorkUnits = workQueue.size();
+        auto lastCheckpoint = std::chrono::steady_clock::now();
+        auto lastReport = lastCheckpoint;
         while (!pauseFlag) {
             std::this_thread::sleep_for(std::chrono::seconds(5));
             if (!pauseFlag) {
-                int64_t completed = workQueueIndex.load();
+                int64_t completed = progress.completedCount();
                 double percentage = (totalWorkUnits > 0) ? (100.0 * completed / totalWorkUnits) : 0.0;
                 std::cout << "[Progress] " << std::fixed << std::setprecision(2) << percentage << "% "
                           << "(" << completed << "/" << totalWorkUnits << " units) | "
                           << "Chunks: " << chunksProcessed.load()
                           << " | Distance: " << maxDistanceReached.load()
-                          << " | Found: " << foundRectangles.size() << "    \r" << std::flush;
+                          << " | Found: " << totalFound();
+                if (engines.searchMode == SearchMode::Largest) {
+                    // With several seeds, the padding every unit still needs
+                    int64_t minDim = -1;
+                    for (const auto& store : results) {
+                        int64_t seedDim = std::max(minimumRectDimension, store->bestShortSide());
+                        minDim = (minDim < 0) ? seedDim : std::min(minDim, seedDim);
+                    }
+                    std::cout << " | Min dim: " << minDim;
+                }
+                if (metrics) {
+                    // Scrolls instead of overwriting, so the breakdown stays readable
+                    std::cout << "\n[Stages] " << metrics->breakdown() << "\n";
+                    metrics->write(metricsPath, chunksProcessed.load(), completed);
+                } else {
+                    std::cout << "    \r" << std::flush;
+                }
 
-                // Write current results to file
-                printStats(chunksProcessed, maxDistanceReached, foundRectangles, true);
+                // Append what was merged since the last pass; compact into the report less often
+                auto now = std::chrono::steady_clock::now();
+                if (now - lastReport >= std::chrono::seconds(REPORT_INTERVAL_SECONDS)) {
+                    writeReports(true);
+                    lastReport = now;
+                } else {
+                    for (size_t k = 0; k < results.size(); k++) {
+                        logs[k]->appendFrom(*handoffs[k]);
+                    }
+                }
+
+                if (now - lastCheckpoint >= std::chrono::seconds(CHECKPOINT_INTERVAL_SECONDS)) {
+                    writeCheckpoint();
+                    lastCheckpoint = now;
+                }
             }
         }
     });
@@ -97,17 +687,44 @@ int main(int argc, char* argv[]) {
     for (auto& t : threads) {
         t.join();
     }
+    if (metrics) {
+        metrics->stop();
+    }
 
     pauseFlag = true;
     monitor.join();
 
+    // Workers flushed their buffers on the way out, so this covers every finished unit
+    if (writeCheckpoint()) {
+        std::cout << "\nCheckpoint saved to " << checkpointPath;
+        if (progress.completedCount() < progress.unitCount()) {
+            std::cout << " (resume with --resume " << checkpointPath << ")";
+        }
+        std::cout << "\n";
+    }
+
     auto endTime = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
 
-    printStats(chunksProcessed, maxDistanceReached, foundRectangles);
+    writeReports(true);
+    writeReports(false);
 
     std::cout << "Total time: " << duration.count() / 1000.0 << " seconds\n";
     std::cout << "Throughput: " << (chunksProcessed.load() * 1000.0 / duration.count()) << " chunks/sec\n";
+    if (engines.scheduler == Scheduler::Stealing) {
+        std::cout << "Work steals: " << workQueue.steals() << "\n";
+    }
+    if (metrics) {
+        std::cout << "Stages: " << metrics->breakdown() << "\n";
+        std::cout << "Unit arena allocations: " << metrics->total().arenaAllocations << "\n";
+        if (!metrics->write(metricsPath, chunksProcessed.load(), progress.completedCount())) {
+            std::cerr << "Cannot write stage metrics to " << metricsPath << "\n";
+        }
+    }
+    if (bitmapCache.isOpen()) {
+        std::cout << "Bitmap cache: " << bitmapCache.tilesFilled() << " tiles filled this run, "
+                  << bitmapCache.validTiles() << "/" << bitmapCache.tileCount() << " valid\n";
+    }
 
     // Clean up signal handler
     g_pauseFlag = nullptr;
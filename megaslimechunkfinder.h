@@ -6,10 +6,195 @@
 #include <mutex>
 #include <atomic>
 #include <cstdint>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <fstream>
+#include <chrono>
 #include <immintrin.h>
 
 // CONFIGURATION
-constexpr int64_t WORK_UNIT_SIZE = 1024;
+constexpr int64_t WORK_UNIT_SIZE = 1024;             // Default work unit side in chunks, see --unit-size
+constexpr int64_t MIN_WORK_UNIT_SIZE = 64;
+constexpr int64_t MAX_WORK_UNIT_SIZE = 65535;        // Heights and edge runs are uint16_t
+constexpr int64_t RESULT_BUFFER_FLUSH_SIZE = 4096;   // Per-thread results buffered before a blocking merge
+constexpr int64_t STEAL_BLOCK_UNITS = 8;             // Spiral cells a worker claims at once when stealing
+constexpr int64_t CHECKPOINT_INTERVAL_SECONDS = 300;
+constexpr int64_t REPORT_INTERVAL_SECONDS = 60;        // Result log compacted into the sorted report
+constexpr int64_t SEED_SWEEP_BLOCK_SIZE = 64;        // Seeds per sweep block, the unit of checkpointing
+constexpr int64_t SEED_SWEEP_GRID_BUDGET = 256LL << 20;   // Bytes of seed grids held by each sweep thread
+constexpr int64_t SEED_SWEEP_DEFAULT_TOP = 100;      // Seeds kept by a sweep without --top
+constexpr int64_t SEED_SPACE_SIZE = 1LL << 48;       // Only the low 48 seed bits reach the slime check
+
+// ENGINE SELECTION
+enum class GridEngine {
+    Batch,           // Coordinate batches through the vector check (16 or 8 lanes)
+    RowIncremental   // Row sweep advancing the X polynomial by finite differences
+};
+
+enum class RectFilter {
+    None,            // Histogram stage scans every row of the unit
+    SquareAnd        // AND-of-rows N x N prefilter hands only candidate row bands to the histogram
+};
+
+enum class RectMode {
+    Exhaustive,      // Every qualifying (start column, end column, row) rectangle, many overlapping
+    Maximal          // Only rectangles that cannot be extended in any direction
+};
+
+enum class Tiling {
+    Padded,          // Each unit recomputes a minimumRectDimension - 1 border around itself
+    Seams            // Units exchange edge runs and complete seam-crossing rectangles from them
+};
+
+enum class SearchMode {
+    Exhaustive,      // Report everything at or above the configured minimum dimension
+    Largest          // Raise the minimum dimension to the best shorter side found so far
+};
+
+enum class Scheduler {
+    Shared,          // Every worker claims single units from one atomic cursor
+    Stealing         // Workers claim blocks into their own ranges and steal from each other
+};
+
+enum class SimdLevel {
+    Scalar,          // Portable scalar kernels, SSE2 baseline only
+    AVX2,            // 8 chunks per step in two 4x64-bit halves
+    AVX512           // 16 chunks per step, needs AVX-512F, AVX-512DQ and AVX-512BW
+};
+
+// Slime chunk kernels for one instruction set. Both fills write chunks
+// [startChunkX, startChunkX + count) at chunkZ into rowBits, LSB-first, and leave the
+// bits past count in the last word clear. fillRowMultiSeed does the same for several
+// world seeds at once, writing the row for worldSeeds[k] to rowBits[k] and sharing the
+// seed-independent polynomial between them. updateHeights is the rectangle stage's
+// per-row step (+1 where rowBits is set, 0 elsewhere) and returns whether any height
+// reached threshold; heights must have room for cols rounded up to 32.
+struct SlimeKernel {
+    SimdLevel level;
+    const char* name;
+    void (*fillRowBatch)(int64_t startChunkX, int64_t chunkZ, int64_t count, int64_t worldSeed, uint64_t* rowBits);
+    void (*fillRowIncremental)(int64_t startChunkX, int64_t chunkZ, int64_t count, int64_t worldSeed, uint64_t* rowBits);
+    void (*fillRowMultiSeed)(int64_t startChunkX, int64_t chunkZ, int64_t count,
+                             const int64_t* worldSeeds, int64_t seedCount, uint64_t* const* rowBits);
+    bool (*updateHeights)(uint16_t* heights, const uint64_t* rowBits, int64_t cols, uint16_t threshold);
+};
+
+// Widest level both the CPU and the OS support, detected once with cpuid/xgetbv
+SimdLevel detectSimdLevel();
+const SlimeKernel& slimeKernelFor(SimdLevel level);
+
+// Compare every fill of a kernel, single and multi-seed, against isSlimeChunk on a spread
+// of rows, including ones that straddle the int32 wrap. Run once at startup before
+// trusting a kernel.
+bool verifySlimeKernel(const SlimeKernel& kernel, int64_t worldSeed);
+
+class BitmapCache;
+class StageMetrics;
+
+// Logical CPU and NUMA node of a worker thread
+struct WorkerPlacement {
+    int cpu = -1;                                // -1: not pinned
+    int node = 0;
+};
+
+struct EngineConfig {
+    SimdLevel simdLevel = SimdLevel::Scalar;   // Set from detectSimdLevel() at startup
+    GridEngine gridEngine = GridEngine::Batch;
+    RectFilter rectFilter = RectFilter::SquareAnd;
+    RectMode rectMode = RectMode::Maximal;
+    SearchMode searchMode = SearchMode::Exhaustive;
+    Tiling tiling = Tiling::Seams;               // Exhaustive rectangle mode always pads
+    BitmapCache* bitmapCache = nullptr;          // Single-seed grids read their bits from here when set
+    StageMetrics* metrics = nullptr;             // Per-stage counters for the workers when set
+    Scheduler scheduler = Scheduler::Stealing;
+    const std::vector<WorkerPlacement>* placement = nullptr;   // By thread id; workers pin themselves when set
+
+    bool seamTiling() const { return tiling == Tiling::Seams && rectMode == RectMode::Maximal; }
+};
+
+const char* gridEngineName(GridEngine engine);
+bool parseGridEngine(const std::string& name, GridEngine& engine);
+const char* rectFilterName(RectFilter filter);
+bool parseRectFilter(const std::string& name, RectFilter& filter);
+const char* rectModeName(RectMode mode);
+bool parseRectMode(const std::string& name, RectMode& mode);
+const char* searchModeName(SearchMode mode);
+bool parseSearchMode(const std::string& name, SearchMode& mode);
+const char* tilingName(Tiling tiling);
+bool parseTiling(const std::string& name, Tiling& tiling);
+const char* schedulerName(Scheduler scheduler);
+bool parseScheduler(const std::string& name, Scheduler& scheduler);
+const char* simdLevelName(SimdLevel level);
+bool parseSimdLevel(const std::string& name, SimdLevel& level);
+
+// STAGE METRICS
+// Hot-path stages, timed with rdtsc when metrics are on. Timers are exclusive: a stage
+// running inside another (the fill of a seamed unit, the lock wait of a merge) is taken
+// out of the outer one, so the stages never count the same cycles twice.
+enum class Stage {
+    Fill,            // Kernel fills and bitmap cache reads, per row
+    Filter,          // Square prefilter, per grid
+    Heights,         // Histogram height update, per scanned row
+    Extension,       // Stack scan or right-extension of a row, reports included
+    Seams,           // Unit edge runs, publishing and seam resolution
+    Merge,           // Result store merges, without the lock wait
+    LockWait,        // Waiting for the result store lock
+    Count
+};
+constexpr int STAGE_COUNT = (int)Stage::Count;
+const char* stageName(Stage stage);
+
+// One worker's counters, alone on their cache lines so workers never share one. Only
+// the owning thread writes them, with plain relaxed stores; the monitor reads them at
+// any time without stopping anyone.
+struct alignas(64) StageCounters {
+    std::atomic<uint64_t> cycles[STAGE_COUNT];
+    std::atomic<uint64_t> calls[STAGE_COUNT];
+    std::atomic<uint64_t> rectangles;        // Handed to result store merges past the admission area
+    std::atomic<uint64_t> deferredMerges;    // Non-blocking merges put off because the lock was taken
+    std::atomic<uint64_t> arenaAllocations;  // Allocations made by the worker's UnitArena
+};
+
+class StageMetrics {
+public:
+    explicit StageMetrics(int64_t threadCount);
+
+    StageCounters& forThread(int64_t threadId) { return slots[threadId % threads]; }
+
+    struct Totals {
+        uint64_t cycles[STAGE_COUNT] = {};
+        uint64_t calls[STAGE_COUNT] = {};
+        uint64_t rectangles = 0;
+        uint64_t deferredMerges = 0;
+        uint64_t arenaAllocations = 0;
+        double seconds = 0;          // Wall time since construction, or until stop()
+        double ticksPerSecond = 0;   // rdtsc rate over that time
+    };
+    Totals total() const;
+
+    // Freeze the wall clock once the workers are done, so later reads don't count the
+    // shutdown as time the workers spent elsewhere
+    void stop();
+
+    // "fill 41% | heights 17% | ..." of the workers' combined wall time, with the rest as "other"
+    std::string breakdown() const;
+
+    // Prometheus text format, written to a temporary file and renamed over path so a
+    // scraper never sees half a file
+    bool write(const std::string& path, int64_t chunksProcessed, int64_t unitsCompleted) const;
+
+private:
+    int64_t threads;
+    std::unique_ptr<StageCounters[]> slots;
+    uint64_t startTicks;
+    std::chrono::steady_clock::time_point startTime;
+    std::atomic<uint64_t> stopTicks{0};
+    std::atomic<int64_t> stopNanoseconds{0};
+};
+
+// Route this thread's stage timers to counters; nullptr turns them off
+void bindStageCounters(StageCounters* counters);
 
 // DATA STRUCTURES
 struct Rectangle {
@@ -21,47 +206,654 @@ struct Rectangle {
     bool operator<(const Rectangle& other) const;
 };
 
+// Row-major bit grid of slime chunks, one bit per chunk (LSB-first within a word).
+// Rows start on 64-byte boundaries so kernels can store whole mask words and the
+// rectangle stage can scan a word at a time. Bits past cols in the last used word
+// of a row are always zero.
+struct SlimeGrid {
+    int64_t rows = 0;
+    int64_t cols = 0;
+    int64_t wordsPerRow = 0;      // Row stride, a multiple of 8 words
+    int64_t capacityWords = 0;
+    uint64_t* bits = nullptr;
+    size_t mappedBytes = 0;       // Non-zero when bits are on pages mapped by reserve(..., true)
+
+    SlimeGrid() = default;
+    SlimeGrid(int64_t rows, int64_t cols);
+    ~SlimeGrid();
+    SlimeGrid(const SlimeGrid&) = delete;
+    SlimeGrid& operator=(const SlimeGrid&) = delete;
+
+    // Reshape the grid, reusing the allocation when it is large enough. Contents are zeroed.
+    void resize(int64_t newRows, int64_t newCols);
+
+    // Make room for a rows x cols grid without reshaping. largePages maps the memory on
+    // huge pages where the OS allows it (transparent huge pages on Linux, MEM_LARGE_PAGES
+    // with SeLockMemoryPrivilege on Windows), else on normal pages.
+    void reserve(int64_t maxRows, int64_t maxCols, bool largePages = false);
+
+    int64_t usedWords() const { return (cols + 63) / 64; }
+    uint64_t* row(int64_t r) { return bits + r * wordsPerRow; }
+    const uint64_t* row(int64_t r) const { return bits + r * wordsPerRow; }
+    bool get(int64_t r, int64_t c) const { return (row(r)[c >> 6] >> (c & 63)) & 1; }
+    void set(int64_t r, int64_t c) { row(r)[c >> 6] |= 1ULL << (c & 63); }
+};
+
+// Lock-free handoff of merged rectangles from the workers to the result log writer: a
+// Treiber stack of batches. Any thread may push; a single consumer drains the whole
+// stack at once, so there is no ABA problem.
+class ResultHandoff {
+public:
+    ResultHandoff() = default;
+    ~ResultHandoff();
+    ResultHandoff(const ResultHandoff&) = delete;
+    ResultHandoff& operator=(const ResultHandoff&) = delete;
+
+    void push(std::vector<Rectangle> batch);
+    std::vector<Rectangle> drain();   // Everything pushed so far, oldest batch first
+
+private:
+    struct Batch {
+        std::vector<Rectangle> rectangles;
+        Batch* next;
+    };
+    std::atomic<Batch*> head{nullptr};
+};
+
+// Shared result set ordered by Rectangle::operator<, optionally bounded to the best K
+// entries. Once full, it publishes the smallest area it still keeps so workers can
+// skip rectangles that could never be admitted.
+class RectangleStore {
+public:
+    explicit RectangleStore(int64_t capacity = 0);   // 0 keeps every rectangle
+
+    // Merge a batch of rectangles and clear it. With blocking == false the merge is
+    // skipped (and false returned) if another thread holds the lock.
+    bool insertBatch(std::vector<Rectangle>& batch, bool blocking);
+
+    // Ordered copy of the current contents, taken under the lock
+    std::vector<Rectangle> snapshot() const;
+
+    int64_t size() const { return count.load(std::memory_order_relaxed); }
+    int64_t capacity() const { return maxEntries; }
+
+    // Rectangles with a smaller area than this cannot be admitted. Equal areas may
+    // still be admitted when they are closer to spawn.
+    int64_t admissionArea() const { return admissionThreshold.load(std::memory_order_relaxed); }
+
+    // Longest shorter side (min of width and height) of any rectangle merged so far
+    int64_t bestShortSide() const { return bestMinSide.load(std::memory_order_relaxed); }
+
+    // Every rectangle merged from now on is also pushed here, outside the lock. Set
+    // before the workers start.
+    void setHandoff(ResultHandoff* target) { handoff = target; }
+
+private:
+    mutable std::mutex mutex;
+    std::set<Rectangle> rectangles;
+    ResultHandoff* handoff = nullptr;
+    int64_t maxEntries;
+    std::atomic<int64_t> count{0};
+    std::atomic<int64_t> admissionThreshold{0};
+    std::atomic<int64_t> bestMinSide{0};
+};
+
+// Append-only text log of merged rectangles, one "x z width height" line (chunks) each,
+// written by the monitor from a ResultHandoff. Duplicates and rectangles a bounded store
+// later evicted stay in the log; compactResultLog settles them.
+class ResultLog {
+public:
+    // keepExisting appends to what's there (resume); otherwise the file is truncated
+    bool open(const std::string& path, bool keepExisting);
+    bool isOpen() const { return out.is_open(); }
+
+    // Drain the handoff and append it, then flush. Returns the number of lines written.
+    int64_t appendFrom(ResultHandoff& handoff);
+
+private:
+    std::ofstream out;
+};
+
+// Compaction: read a log back, drop duplicates, sort by Rectangle::operator< and keep
+// the best capacity entries (0 keeps all). Produces what the store would hold.
+bool compactResultLog(const std::string& path, int64_t capacity, std::vector<Rectangle>& rectangles);
+
+// Completion bitset over work unit indices. Units are claimed out of order by the
+// worker threads, so each one is marked on its own. A unit is only marked once its
+// rectangles are in the RectangleStore, which makes "bits first, then results" a
+// consistent snapshot order.
+class WorkProgress {
+public:
+    explicit WorkProgress(int64_t units = 0) { reset(units); }
+
+    void reset(int64_t units);
+    void markDone(int64_t index);
+    bool isDone(int64_t index) const;
+
+    int64_t unitCount() const { return units; }
+    int64_t completedCount() const { return completed.load(std::memory_order_relaxed); }
+
+    std::vector<uint64_t> snapshotWords() const;
+    bool loadWords(const std::vector<uint64_t>& source);   // false if the size doesn't match
+
+private:
+    int64_t units = 0;
+    int64_t wordCount = 0;
+    std::unique_ptr<std::atomic<uint64_t>[]> words;
+    std::atomic<int64_t> completed{0};
+};
+
+// A work unit in chunk coordinates, [minX, maxX) x [minZ, maxZ). The index is the
+// unit's position in the x-major unit grid, so it does not depend on claim order.
+struct WorkUnit {
+    int64_t minX, maxX, minZ, maxZ;
+    int64_t index;
+};
+
+// Logical CPUs of each NUMA node, from /sys/devices/system/node on Linux and
+// GetNumaNodeProcessorMaskEx on Windows, limited to the CPUs this process may run on.
+// One node holding every CPU when the topology is unknown.
+std::vector<std::vector<int>> detectNumaNodes();
+
+// Worker t goes to the t-th CPU in node order, so a pool smaller than the machine stays
+// on as few nodes as possible; larger pools wrap around. No nodes leaves every worker
+// unpinned on node 0.
+std::vector<WorkerPlacement> planWorkerPlacement(int64_t threads, const std::vector<std::vector<int>>& nodes);
+
+// Pin the calling thread to a logical CPU. False if the OS refused or cpu is -1.
+bool pinCurrentThread(int cpu);
+
+// Lazy work generator. Units are handed out in concentric square rings around the unit
+// nearest the origin, from a single atomic cursor, so nothing is materialized and
+// startup is O(1). Ring r holds the 8r units at Chebyshev distance r from the center;
+// within a ring the units nearest the side midpoints come first, keeping the order
+// close to the Euclidean one. Ring cells outside the search bounds are skipped.
+//
+// With work stealing the cursor hands out STEAL_BLOCK_UNITS cells at a time into each
+// worker's own range, which the worker consumes front to back. Once the spiral is
+// handed out, an idle worker takes the far half of another worker's range, trying the
+// workers on its own NUMA node first. The order stays closest-first to within one block
+// per worker.
+class SpiralWorkQueue {
+public:
+    SpiralWorkQueue(int64_t searchMinX, int64_t searchMaxX, int64_t searchMinZ, int64_t searchMaxZ,
+                    int64_t unitSize = WORK_UNIT_SIZE);
+
+    // Claim the next unit. Returns false once every ring has been handed out.
+    bool next(WorkUnit& unit);
+
+    // Give each worker in placement its own range. Call before the workers start; without
+    // it next(unit, thread) is next(unit).
+    void enableStealing(const std::vector<WorkerPlacement>& placement);
+    bool next(WorkUnit& unit, int64_t thread);
+    int64_t steals() const { return stealCount.load(std::memory_order_relaxed); }
+
+    // Unit at a position of the spiral order; false if that cell is out of bounds
+    bool unitAtSpiral(int64_t spiralIndex, WorkUnit& unit) const;
+    WorkUnit unitAt(int64_t index) const;
+
+    int64_t size() const { return unitsX * unitsZ; }
+    int64_t spiralLength() const { return spiralCells; }
+    int64_t unitsAlongX() const { return unitsX; }
+    int64_t unitsAlongZ() const { return unitsZ; }
+    int64_t unitSize() const { return unitChunks; }
+
+private:
+    int64_t minChunkX, maxChunkX, minChunkZ, maxChunkZ;
+    int64_t unitChunks;
+    int64_t unitsX, unitsZ;
+    int64_t centerX, centerZ;
+    int64_t spiralCells;              // (2 * maxRing + 1)^2, or 0 for an empty search
+    std::atomic<int64_t> cursor{0};
+
+    // Spiral cells [begin, end) a worker still has to claim. The owner takes from the
+    // front, thieves from the back.
+    struct alignas(64) ThreadRange {
+        std::mutex lock;
+        int64_t begin = 0;
+        int64_t end = 0;
+    };
+    bool refill(int64_t thread);
+
+    std::unique_ptr<ThreadRange[]> threadRanges;
+    std::vector<std::vector<int64_t>> victimOrder;   // Per worker: whom to steal from, nearest first
+    std::atomic<int64_t> stealCount{0};
+};
+
+// On-disk slime bitmap, one tile per work unit at 1 bit per chunk, memory-mapped
+// (CreateFileMapping on Windows, mmap elsewhere). A tile is filled the first time a grid
+// needs it and marked valid once written, so later runs over the same seed and unit grid
+// (say with another --min-dim or rectangle mode) read their bits instead of hashing them.
+// The file is sparse: only tiles that were filled take disk space.
+class BitmapCache {
+public:
+    BitmapCache() = default;
+    ~BitmapCache() { close(); }
+    BitmapCache(const BitmapCache&) = delete;
+    BitmapCache& operator=(const BitmapCache&) = delete;
+
+    // Open path, or create it, for this seed and unit grid. A file written for another
+    // seed or grid is rejected rather than overwritten.
+    bool open(const std::string& path, int64_t worldSeed, const SpiralWorkQueue& workQueue);
+    void close();   // Flushes and unmaps
+    bool isOpen() const { return base != nullptr; }
+
+    // Write chunks [startChunkX, startChunkX + count) at chunkZ into rowBits like a kernel
+    // fill, filling the tiles the row crosses if they aren't valid yet. Rows outside the
+    // unit grid, and tiles another thread is still filling, are computed directly.
+    void readRow(int64_t startChunkX, int64_t chunkZ, int64_t count, uint64_t* rowBits,
+                 const EngineConfig& engines);
+
+    int64_t tileCount() const { return tilesX * tilesZ; }
+    int64_t validTiles() const { return valid.load(std::memory_order_relaxed); }
+    int64_t tilesFilled() const { return filled.load(std::memory_order_relaxed); }   // By this process
+
+private:
+    bool ensureTile(int64_t tile, const EngineConfig& engines);   // False while another thread fills it
+    uint64_t* tileRow(int64_t tile, int64_t row) const;
+    void computeRow(int64_t startChunkX, int64_t chunkZ, int64_t count, uint64_t* rowBits,
+                    const EngineConfig& engines) const;
+
+    int64_t worldSeed = 0;
+    int64_t minChunkX = 0, maxChunkX = 0, minChunkZ = 0, maxChunkZ = 0;
+    int64_t unitChunks = 0;
+    int64_t tilesX = 0, tilesZ = 0;
+    int64_t wordsPerTileRow = 0;
+    uint64_t tileBytes = 0;
+    uint64_t tilesOffset = 0;
+    uint64_t mappedBytes = 0;
+
+    unsigned char* base = nullptr;                       // Whole file, mapped read-write
+    unsigned char* validBytes = nullptr;                 // One byte per tile in the file, 1 once written
+    std::unique_ptr<std::atomic<uint8_t>[]> states;      // Empty, filling or valid, per tile
+    std::atomic<int64_t> valid{0};
+    std::atomic<int64_t> filled{0};
+    void* fileHandle = nullptr;                          // HANDLEs on Windows
+    void* mappingHandle = nullptr;
+    int fileDescriptor = -1;
+};
+
+// Runs of slime chunks touching each edge of a work unit. This is all a neighbour needs
+// to finish the rectangles crossing their shared seam, so no chunk is hashed twice.
+// Runs stop at the unit's own far edge, which assumes no rectangle spans a whole unit.
+struct UnitEdges {
+    std::vector<uint16_t> topDepths;       // Per column: set bits going down from the first row
+    std::vector<uint16_t> bottomHeights;   // Per column: set bits going up from the last row
+    std::vector<uint16_t> leftRuns;        // Per row: set bits going right from the first column
+    std::vector<uint16_t> rightRuns;       // Per row: set bits going left from the last column
+};
+static_assert(MAX_WORK_UNIT_SIZE <= 65535, "UnitEdges stores runs as uint16_t");
+
+// Boundary exchange for seam tiling. Each unit publishes its edges and the rectangles
+// that are maximal inside it. Once all units of its 3x3 block have published, the unit
+// is resolved: its edge-touching rectangles are dropped if a neighbour extends them, and
+// the seams on its top and left side are solved as 1-D problems over the edge runs.
+// Every globally maximal rectangle is reported by exactly one unit: interior ones by
+// the unit holding them, seam-crossing ones by the unit holding their top-left seam cell.
+class SeamTracker {
+public:
+    SeamTracker(const SpiralWorkQueue& workQueue, const WorkProgress& progress);
+
+    // False once the unit and its whole 3x3 block were completed before a resume
+    bool needsEdges(int64_t index) const;
+
+    // Record a processed unit. Units that became ready to resolve are appended to readyUnits.
+    void publish(int64_t index, std::shared_ptr<const UnitEdges> edges,
+                 std::vector<Rectangle>&& rectangles, std::vector<int64_t>& readyUnits);
+
+    // Report the final rectangles owned by a ready unit into results
+    void resolve(int64_t index, int64_t minimumRectDimension, int64_t minimumArea,
+                 std::vector<Rectangle>& results);
+
+    // Units published or waited on but not yet released
+    int64_t trackedUnits() const;
+
+private:
+    struct UnitState {
+        std::shared_ptr<const UnitEdges> edges;
+        std::vector<Rectangle> rectangles;
+        int64_t waitingOn = 0;      // Units of the 3x3 block (itself included) not yet published
+        int64_t edgeReaders = 0;    // Units of the 3x3 block whose resolve still reads these edges
+        bool published = false;
+    };
+
+    UnitState& stateFor(int64_t index);   // Caller holds the mutex
+
+    const SpiralWorkQueue& workQueue;
+    const WorkProgress& progress;
+    mutable std::mutex mutex;
+    std::unordered_map<int64_t, UnitState> units;
+};
+
+// On-disk search state. The search identity (seeds, bounds, dimension, unit size,
+// rectangle mode and tiling) must match on resume, since unit indices refer to the unit grid
+// those settings produce. rectangles[k] holds the results for worldSeeds[k].
+struct Checkpoint {
+    std::vector<int64_t> worldSeeds;
+    int64_t searchMinX = 0, searchMaxX = 0, searchMinZ = 0, searchMaxZ = 0;
+    int64_t minimumRectDimension = 0;
+    int64_t workUnitSize = 0;
+    int64_t rectMode = 0;
+    int64_t tiling = 0;
+    int64_t unitCount = 0;
+    int64_t chunksProcessed = 0;
+    int64_t maxDistanceReached = 0;
+    std::vector<uint64_t> completedUnits;
+    std::vector<std::vector<Rectangle>> rectangles;
+
+    bool sameSearch(const Checkpoint& other) const;
+};
+
+// Written to path + ".tmp" and renamed over path, so a crash mid-write leaves the
+// previous checkpoint intact
+bool saveCheckpoint(const std::string& path, const Checkpoint& checkpoint);
+bool loadCheckpoint(const std::string& path, Checkpoint& checkpoint);
+
+// SEED SWEEP
+// The inverse search: a fixed region and a range of world seeds, ranked by the best
+// rectangle each seed has in the region.
+struct SeedRectangle {
+    int64_t worldSeed;
+    Rectangle rect;
+
+    bool operator<(const SeedRectangle& other) const;   // Rectangle order, then seed
+};
+
+// Shared top-K of seeds, one entry per seed. Same admission rule as RectangleStore.
+class SeedResultStore {
+public:
+    explicit SeedResultStore(int64_t capacity = SEED_SWEEP_DEFAULT_TOP);   // 0 keeps every seed
+
+    void insertBatch(std::vector<SeedRectangle>& batch);   // Merges and clears the batch
+    std::vector<SeedRectangle> snapshot() const;
+
+    int64_t size() const { return count.load(std::memory_order_relaxed); }
+    int64_t capacity() const { return maxEntries; }
+    int64_t admissionArea() const { return admissionThreshold.load(std::memory_order_relaxed); }
+
+private:
+    mutable std::mutex mutex;
+    std::set<SeedRectangle> entries;
+    int64_t maxEntries;
+    std::atomic<int64_t> count{0};
+    std::atomic<int64_t> admissionThreshold{0};
+};
+
+// Hands out blocks of SEED_SWEEP_BLOCK_SIZE consecutive seeds from [seedStart, seedEnd)
+// from an atomic cursor. A 48-bit range has far too many blocks for a completion bitset,
+// so progress is a watermark: every block below completedBlocks() is done. Blocks
+// finished above it are remembered until the gap closes.
+class SeedSweepQueue {
+public:
+    SeedSweepQueue(int64_t seedStart, int64_t seedEnd, int64_t completedBlocks = 0);
+
+    bool next(int64_t& block);   // False once every block has been claimed
+    void markDone(int64_t block);
+
+    int64_t blockCount() const { return blocks; }
+    int64_t completedBlocks() const;
+    int64_t firstSeed(int64_t block) const { return seedStart + block * SEED_SWEEP_BLOCK_SIZE; }
+    int64_t seedCount(int64_t block) const;
+
+private:
+    int64_t seedStart;
+    int64_t seedEnd;
+    int64_t blocks;
+    std::atomic<int64_t> cursor;
+    mutable std::mutex mutex;
+    int64_t watermark;
+    std::set<int64_t> doneAhead;
+};
+
+// Seeds of a block that share one pass over a width x height chunk region: as many as
+// fit SEED_SWEEP_GRID_BUDGET, at most SEED_SWEEP_BLOCK_SIZE. 0 when a single seed's grid
+// is over the budget, so the region can't be swept.
+int64_t seedSweepPassSeeds(int64_t width, int64_t height);
+
+// Fill the region [minX, maxX) x [minZ, maxZ) (chunks) for seeds [firstSeed,
+// firstSeed + seedCount) in multi-seed passes of grids.size() seeds and append each
+// seed's best maximal rectangle with both sides >= minimumRectDimension and area >=
+// minimumArea. seedCount is at most SEED_SWEEP_BLOCK_SIZE, and grids is scratch space of
+// at least one grid, kept between calls.
+void processSeedBlock(int64_t firstSeed, int64_t seedCount,
+                      int64_t minX, int64_t maxX, int64_t minZ, int64_t maxZ,
+                      int64_t minimumRectDimension, int64_t minimumArea,
+                      std::vector<SlimeGrid>& grids,
+                      std::vector<SeedRectangle>& results,
+                      const EngineConfig& engines);
+
+// Parallel across seeds: each thread claims whole seed blocks and keeps
+// seedSweepPassSeeds grids for them. A block is marked done only after its seeds are in
+// the store. Pins itself like a region worker when engines.placement is set.
+void seedSweepThread(int64_t threadId,
+                     int64_t minX, int64_t maxX, int64_t minZ, int64_t maxZ,
+                     int64_t minimumRectDimension,
+                     SeedSweepQueue& queue,
+                     SeedResultStore& results,
+                     std::atomic<bool>& pauseFlag,
+                     std::atomic<int64_t>& seedsProcessed,
+                     const EngineConfig& engines);
+
+// Sweep state on disk. The seed range, region (blocks) and dimension must match on
+// resume; completedBlocks is the queue's watermark.
+struct SeedSweepCheckpoint {
+    int64_t seedStart = 0, seedEnd = 0;
+    int64_t searchMinX = 0, searchMaxX = 0, searchMinZ = 0, searchMaxZ = 0;
+    int64_t minimumRectDimension = 0;
+    int64_t completedBlocks = 0;
+    int64_t seedsProcessed = 0;
+    std::vector<SeedRectangle> results;
+
+    bool sameSweep(const SeedSweepCheckpoint& other) const;
+};
+
+bool saveSeedSweepCheckpoint(const std::string& path, const SeedSweepCheckpoint& checkpoint);
+bool loadSeedSweepCheckpoint(const std::string& path, SeedSweepCheckpoint& checkpoint);
+
 // SLIME CHUNK DETECTION
+// The Vec16 functions need AVX-512F/DQ and the Vec8 functions need AVX2; only call them
+// when detectSimdLevel() reports at least that level.
 bool isSlimeChunk(int64_t chunkX, int64_t chunkZ, int64_t worldSeed);
-void isSlimeChunkVec16(const int64_t* chunkX, const int64_t* chunkZ, int64_t worldSeed, bool* results);
+__mmask16 isSlimeChunkVec16(const int64_t* chunkX, const int64_t* chunkZ, int64_t worldSeed);
+void isSlimeChunkRowVec16(int64_t startChunkX, int64_t chunkZ, int64_t count, int64_t worldSeed, uint64_t* rowBits);
+uint8_t isSlimeChunkVec8(const int64_t* chunkX, const int64_t* chunkZ, int64_t worldSeed);
+void isSlimeChunkRowVec8(int64_t startChunkX, int64_t chunkZ, int64_t count, int64_t worldSeed, uint64_t* rowBits);
+void isSlimeChunkRowScalar(int64_t startChunkX, int64_t chunkZ, int64_t count, int64_t worldSeed, uint64_t* rowBits);
 
 // RECTANGLE FINDING
-void findMaximalRectangles(const std::vector<std::vector<bool>>& grid,
+bool findSquareCandidateBands(const SlimeGrid& grid, int64_t minimumRectDimension,
+                              std::vector<std::pair<int64_t, int64_t>>& bands,
+                              std::vector<uint64_t>* window = nullptr);   // Scratch, local if null
+
+// Streaming histogram stage. Rows are pushed top to bottom and only a rolling uint16
+// height per column and the monotonic stack are kept, so memory is O(cols) whatever the
+// number of rows. Maximal mode needs the row below to rule out downward extension, so
+// each row is scanned when the next one arrives and the last one by finish(). Heights
+// are updated by the kernel of the given SIMD level, which also skips the scan of rows
+// where no column is as tall as the minimum dimension. A pushed row is a grid row (whole
+// words, bits past cols clear) and must stay valid until the following pushRow or
+// finish. Runs of set bits longer than 65535 rows are not supported.
+class RectangleScanner {
+public:
+    RectangleScanner(int64_t cols, int64_t offsetX, int64_t offsetZ,
+                     int64_t minimumRectDimension, RectMode rectMode,
+                     int64_t minimumArea = 0, bool debugMode = false,
+                     SimdLevel simdLevel = SimdLevel::Scalar);
+
+    // Reconfigure for another grid, keeping the buffers when they are large enough
+    void reset(int64_t cols, int64_t offsetX, int64_t offsetZ,
+               int64_t minimumRectDimension, RectMode rectMode,
+               int64_t minimumArea = 0, bool debugMode = false,
+               SimdLevel simdLevel = SimdLevel::Scalar);
+
+    // Start a new scan whose first row is at chunk Z offsetZ + firstRow
+    void begin(int64_t firstRow);
+    void pushRow(const uint64_t* rowBits, std::vector<Rectangle>& results);
+    void finish(std::vector<Rectangle>& results);
+
+    // Bytes held by the height and stack buffers
+    size_t capacityBytes() const {
+        return heights.capacity() * sizeof(uint16_t) + stack.capacity() * sizeof(stack[0]);
+    }
+
+private:
+    void scanPendingRow(const uint64_t* nextRowBits, std::vector<Rectangle>& results);
+    void report(int64_t left, int64_t width, int64_t height, std::vector<Rectangle>& results);
+
+    int64_t cols, words;
+    int64_t offsetX, offsetZ;
+    int64_t minimumRectDimension, minimumArea;
+    RectMode rectMode;
+    bool debugMode;
+    const SlimeKernel* kernel;
+    uint16_t tallThreshold;
+
+    std::vector<uint16_t> heights;                       // Column heights ending at the pending row
+    std::vector<std::pair<int64_t, int64_t>> stack;      // (height, left column)
+    const uint64_t* pendingRow = nullptr;
+    int64_t pendingIndex = 0;
+    bool pendingTall = false;                            // Some height of the pending row reaches the minimum
+};
+
+// Per-worker scratch for one work unit: the grid, the rectangle scanner and the square
+// filter's window and bands. A worker sizes it for its largest padded unit up front, with the grid
+// on huge pages, and reuses it for every unit, so once warm a unit allocates nothing for
+// them. Every allocation it does make is counted, also in the bound StageCounters.
+class UnitArena {
+public:
+    UnitArena() = default;                                   // Grows on first use
+    UnitArena(int64_t maxRows, int64_t maxCols, SimdLevel simdLevel);
+
+    SlimeGrid& grid(int64_t rows, int64_t cols);             // Reshaped and zeroed
+    RectangleScanner& scanner(int64_t cols, int64_t offsetX, int64_t offsetZ,
+                              int64_t minimumRectDimension, RectMode rectMode,
+                              int64_t minimumArea, bool debugMode, SimdLevel simdLevel);
+    std::vector<std::pair<int64_t, int64_t>>& bands();       // Cleared
+    std::vector<uint64_t>& filterWindow() { return window; }
+    std::vector<Rectangle>& found();                         // Cleared; a padded grid's rectangles before settling
+
+    int64_t allocations() const { return allocationCount; }
+    size_t bytes() const;
+
+private:
+    void countAllocation();
+
+    SlimeGrid slimeGrid;
+    RectangleScanner rectangleScanner{0, 0, 0, 1, RectMode::Maximal};
+    std::vector<std::pair<int64_t, int64_t>> candidateBands;
+    std::vector<uint64_t> window;
+    std::vector<Rectangle> foundRectangles;
+    size_t foundCapacity = 0;
+    int64_t allocationCount = 0;
+};
+
+// Side of the largest grid processRegion builds for a unit, in either rectangle mode,
+// before any rescan; what a worker sizes its arena for under padded tiling
+int64_t paddedUnitSide(int64_t unitSize, int64_t minimumRectDimension);
+
+// Runs a RectangleScanner over rows [startRow, endRow) of a grid
+void findMaximalRectangles(const SlimeGrid& grid,
                            int64_t startRow, int64_t endRow,
                            int64_t offsetX, int64_t offsetZ,
                            int64_t minimumRectDimension,
-                           std::mutex& resultsMutex,
-                           std::set<Rectangle>& foundRectangles,
-                           bool debugMode = false);
+                           std::vector<Rectangle>& results,
+                           RectMode rectMode = RectMode::Maximal,
+                           int64_t minimumArea = 0,
+                           bool debugMode = false,
+                           SimdLevel simdLevel = SimdLevel::Scalar);
 
+// Padded-tiling scan of one unit. In maximal mode the unit reports the maximal rectangles
+// of the search region whose top-left corner it holds, rescanning with a wider margin when
+// one reaches past its grid. In exhaustive mode it reports everything in its grid padded
+// by minimumRectDimension - 1, duplicates included.
 void processRegion(int64_t minX, int64_t maxX, int64_t minZ, int64_t maxZ,
                    int64_t worldSeed,
                    int64_t minimumRectDimension,
+                   int64_t minimumArea,
                    int64_t searchMinX, int64_t searchMaxX, int64_t searchMinZ, int64_t searchMaxZ,
-                   std::mutex& resultsMutex,
-                   std::set<Rectangle>& foundRectangles,
+                   std::vector<Rectangle>& localResults,
                    std::atomic<int64_t>& chunksProcessed,
-                   bool debugMode = false);
+                   const EngineConfig& engines,
+                   bool debugMode = false,
+                   UnitArena* arena = nullptr);
+
+// Multi-seed counterpart of processRegion. Each chunk's seed-independent polynomial is
+// computed once and finished for every seed, into one grid and result list per seed.
+// minimumRectDimension sets the padding; seed k is scanned with seedDimensions[k] and
+// seedAreas[k], which may only be larger. arenas, when given, holds one arena per seed.
+void processRegionMultiSeed(int64_t minX, int64_t maxX, int64_t minZ, int64_t maxZ,
+                            const std::vector<int64_t>& worldSeeds,
+                            int64_t minimumRectDimension,
+                            const std::vector<int64_t>& seedDimensions,
+                            const std::vector<int64_t>& seedAreas,
+                            int64_t searchMinX, int64_t searchMaxX, int64_t searchMinZ, int64_t searchMaxZ,
+                            std::vector<std::vector<Rectangle>>& localResults,
+                            std::atomic<int64_t>& chunksProcessed,
+                            const EngineConfig& engines,
+                            bool debugMode = false,
+                            const std::vector<std::unique_ptr<UnitArena>>* arenas = nullptr);
 
-void generateWorkQueue(int64_t searchMinX, int64_t searchMaxX, int64_t searchMinZ, int64_t searchMaxZ,
-                       std::vector<std::pair<std::pair<int64_t, int64_t>, std::pair<int64_t, int64_t>>>& workQueue);
+// Seam-tiling counterpart of processRegion: the unit is scanned without padding and its
+// edge runs are returned for SeamTracker. With scanRectangles false only the edges are
+// computed, for units finished before a resume whose neighbours still need them.
+void processUnitSeamed(const WorkUnit& unit,
+                       int64_t worldSeed,
+                       int64_t minimumRectDimension,
+                       int64_t minimumArea,
+                       UnitEdges& edges,
+                       std::vector<Rectangle>& unitResults,
+                       bool scanRectangles,
+                       const EngineConfig& engines,
+                       bool debugMode = false,
+                       UnitArena* arena = nullptr);
 
 void workerThread(int64_t threadId, int64_t numThreads,
                   int64_t worldSeed,
                   int64_t minimumRectDimension,
                   int64_t searchMinX, int64_t searchMaxX, int64_t searchMinZ, int64_t searchMaxZ,
-                  std::mutex& resultsMutex,
-                  std::set<Rectangle>& foundRectangles,
+                  RectangleStore& results,
                   std::atomic<bool>& pauseFlag,
                   std::atomic<int64_t>& chunksProcessed,
                   std::atomic<int64_t>& maxDistanceReached,
-                  std::vector<std::pair<std::pair<int64_t, int64_t>, std::pair<int64_t, int64_t>>>& workQueue,
-                  std::atomic<int64_t>& workQueueIndex,
+                  SpiralWorkQueue& workQueue,
+                  WorkProgress& progress,
+                  SeamTracker& seams,
+                  const EngineConfig& engines,
                   bool debugMode = false);
 
+// Worker for a batch of seeds sharing one pass over the coordinates; results[k] collects
+// worldSeeds[k]. Always uses padded tiling, since SeamTracker holds a single seed's edges.
+void multiSeedWorkerThread(int64_t threadId,
+                           const std::vector<int64_t>& worldSeeds,
+                           int64_t minimumRectDimension,
+                           int64_t searchMinX, int64_t searchMaxX, int64_t searchMinZ, int64_t searchMaxZ,
+                           std::vector<std::unique_ptr<RectangleStore>>& results,
+                           std::atomic<bool>& pauseFlag,
+                           std::atomic<int64_t>& chunksProcessed,
+                           std::atomic<int64_t>& maxDistanceReached,
+                           SpiralWorkQueue& workQueue,
+                           WorkProgress& progress,
+                           const EngineConfig& engines,
+                           bool debugMode = false);
+
+// Report of a sorted result list; capacity and admissionArea describe the store bound
 void printStats(const std::atomic<int64_t>& chunksProcessed,
                 const std::atomic<int64_t>& maxDistanceReached,
-                const std::set<Rectangle>& foundRectangles,
-                bool toFile = false);
+                const std::vector<Rectangle>& foundRectangles,
+                int64_t capacity,
+                int64_t admissionArea,
+                bool toFile = false,
+                const std::string& fileName = "slimechunkfinder.txt");
+
+void printStats(const std::atomic<int64_t>& chunksProcessed,
+                const std::atomic<int64_t>& maxDistanceReached,
+                const RectangleStore& results,
+                bool toFile = false,
+                const std::string& fileName = "slimechunkfinder.txt");
+
+void printSeedSweepStats(int64_t seedsProcessed,
+                         const SeedResultStore& results,
+                         bool toFile = false,
+                         const std::string& fileName = "slimeseeds.txt");
 
 #endif // MEGASLIMECHUNKFINDER_H
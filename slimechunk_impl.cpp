@@ -1,31 +1,172 @@
 #include "megaslimechunkfinder.h"
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <algorithm>
 #include <thread>
 #include <chrono>
 #include <csignal>
 #include <iomanip>
 #include <cstring>
+#include <cerrno>
 #include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <bitset>
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <malloc.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define NOGDI            // wingdi.h declares a Rectangle() function
+#include <windows.h>
+#include <winioctl.h>
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// The program is built for the baseline x86-64 target and picks its kernels at runtime.
+// MSVC accepts any intrinsic without /arch; GCC and Clang need the ISA enabled on each
+// function that uses it.
+#if defined(__GNUC__) || defined(__clang__)
+#define SLIME_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx512bw")))
+#define SLIME_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SLIME_TARGET_AVX512
+#define SLIME_TARGET_AVX2
+#endif
+
+// BIT HELPERS
+static inline int64_t countTrailingZeros64(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return (int64_t)index;
+#else
+    return (int64_t)__builtin_ctzll(value);
+#endif
+}
+
+static void* alignedAlloc64(size_t bytes) {
+#ifdef _MSC_VER
+    return _aligned_malloc(bytes, 64);
+#else
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, 64, bytes) == 0 ? ptr : nullptr;
+#endif
+}
+
+static void alignedFree64(void* ptr) {
+#ifdef _MSC_VER
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+// Page-mapped allocation for long-lived scratch, on huge pages where the OS allows.
+// Linux maps a 2 MiB aligned range and asks for transparent huge pages; Windows tries
+// MEM_LARGE_PAGES, which needs SeLockMemoryPrivilege, and otherwise uses normal pages.
+// Returns nullptr on failure; mappedBytes is what largePageFree needs back.
+static void* largePageAlloc(size_t bytes, size_t& mappedBytes) {
+#ifdef _WIN32
+    SIZE_T largePage = GetLargePageMinimum();
+    if (largePage > 0) {
+        size_t length = (bytes + largePage - 1) / largePage * largePage;
+        void* ptr = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (ptr != nullptr) {
+            mappedBytes = length;
+            return ptr;
+        }
+    }
+    size_t length = (bytes + 4095) & ~(size_t)4095;
+    void* ptr = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    mappedBytes = (ptr != nullptr) ? length : 0;
+    return ptr;
+#else
+    const size_t HUGE_PAGE = (size_t)2 << 20;
+    size_t length = (bytes + HUGE_PAGE - 1) & ~(HUGE_PAGE - 1);
+    void* raw = mmap(nullptr, length + HUGE_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return nullptr;
+    }
+    // Trim to a huge page boundary so the whole range can be backed by huge pages
+    uintptr_t start = ((uintptr_t)raw + HUGE_PAGE - 1) & ~(uintptr_t)(HUGE_PAGE - 1);
+    size_t head = start - (uintptr_t)raw;
+    if (head > 0) {
+        munmap(raw, head);
+    }
+    if (HUGE_PAGE - head > 0) {
+        munmap((char*)start + length, HUGE_PAGE - head);
+    }
+#ifdef MADV_HUGEPAGE
+    madvise((void*)start, length, MADV_HUGEPAGE);
+#endif
+    mappedBytes = length;
+    return (void*)start;
+#endif
+}
+
+static void largePageFree(void* ptr, size_t mappedBytes) {
+#ifdef _WIN32
+    (void)mappedBytes;
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, mappedBytes);
+#endif
+}
 
 // AVX-512 SLIME CHUNK DETECTION
 
-// AVX-512 optimized slime chunk detection for 16 chunks in parallel.
-// Uses 32-bit SIMD operations for 2x throughput.
-inline void isSlimeChunkVec16(const int64_t* chunkX, const int64_t* chunkZ, int64_t worldSeed, bool* results) {
-    // Convert to int32_t
-    alignas(64) int32_t x_i32[16];
-    alignas(64) int32_t z_i32[16];
+// Finish 16 slime chunk checks from their pre-scramble seeds (worldSeed plus the four
+// polynomial terms), split into two halves of 8x64-bit lanes. Everything stays in zmm
+// registers and the result comes back as one bit per lane.
+SLIME_TARGET_AVX512 static inline __mmask16 slimeSeedTailVec16(__m512i seedLo, __m512i seedHi) {
+    // Both XORs fold into one constant: (s ^ 0x3ad8025f) ^ 0x5DEECE66D.
+    // Masking to 48 bits before the LCG multiply is unnecessary since the low 48 bits
+    // of the product only depend on the low 48 bits of the operands.
+    const __m512i scramble = _mm512_set1_epi64(0x3ad8025fLL ^ 0x5DEECE66DLL);
+    const __m512i multiplier = _mm512_set1_epi64(0x5DEECE66DLL);
+    const __m512i addend = _mm512_set1_epi64(0xBLL);
+    const __m512i mask48 = _mm512_set1_epi64(0xFFFFFFFFFFFFLL);
     
-    for (int i = 0; i < 16; i++) {
-        x_i32[i] = (int32_t)chunkX[i];
-        z_i32[i] = (int32_t)chunkZ[i];
-    }
+    seedLo = _mm512_xor_si512(seedLo, scramble);
+    seedHi = _mm512_xor_si512(seedHi, scramble);
+    seedLo = _mm512_and_si512(_mm512_add_epi64(_mm512_mullo_epi64(seedLo, multiplier), addend), mask48);
+    seedHi = _mm512_and_si512(_mm512_add_epi64(_mm512_mullo_epi64(seedHi, multiplier), addend), mask48);
     
-    // Load as 32-bit integers
-    __m512i x = _mm512_load_si512((__m512i*)x_i32);
-    __m512i z = _mm512_load_si512((__m512i*)z_i32);
+    // Bits [17..47] fit in 31 bits, so the 32-bit value is non-negative
+    __m256i bitsLo = _mm512_cvtepi64_epi32(_mm512_srli_epi64(seedLo, 17));
+    __m256i bitsHi = _mm512_cvtepi64_epi32(_mm512_srli_epi64(seedHi, 17));
+    __m512i bits = _mm512_inserti64x4(_mm512_castsi256_si512(bitsLo), bitsHi, 1);
+    
+    // n % 10 == 0 iff rotr(n * inverse(5), 1) <= (2^32 - 1) / 10
+    __m512i scaled = _mm512_mullo_epi32(bits, _mm512_set1_epi32((int32_t)0xCCCCCCCDu));
+    __m512i rotated = _mm512_ror_epi32(scaled, 1);
+    return _mm512_cmple_epu32_mask(rotated, _mm512_set1_epi32(0x19999999));
+}
+
+// AVX-512 optimized slime chunk detection for 16 chunks in parallel.
+// Uses 32-bit SIMD operations for the polynomial terms. Bit i of the result is set
+// when chunk i is a slime chunk.
+SLIME_TARGET_AVX512 __mmask16 isSlimeChunkVec16(const int64_t* chunkX, const int64_t* chunkZ, int64_t worldSeed) {
+    // Truncate to int32_t (Java int) and pack 16 lanes per register
+    __m256i xLo = _mm512_cvtepi64_epi32(_mm512_loadu_si512((const void*)chunkX));
+    __m256i xHi = _mm512_cvtepi64_epi32(_mm512_loadu_si512((const void*)(chunkX + 8)));
+    __m256i zLo = _mm512_cvtepi64_epi32(_mm512_loadu_si512((const void*)chunkZ));
+    __m256i zHi = _mm512_cvtepi64_epi32(_mm512_loadu_si512((const void*)(chunkZ + 8)));
+    __m512i x = _mm512_inserti64x4(_mm512_castsi256_si512(xLo), xHi, 1);
+    __m512i z = _mm512_inserti64x4(_mm512_castsi256_si512(zLo), zHi, 1);
     
     // All intermediate calculations in 32-bit
     __m512i x_x = _mm512_mullo_epi32(x, x);
@@ -35,40 +176,391 @@ inline void isSlimeChunkVec16(const int64_t* chunkX, const int64_t* chunkZ, int6
     __m512i term2 = _mm512_mullo_epi32(x, _mm512_set1_epi32(0x5ac0db));
     __m512i term4 = _mm512_mullo_epi32(z, _mm512_set1_epi32(0x5f24f));
     
+    // Sign-extend the 32-bit terms and sum them in 64-bit lanes.
     // term3 requires 64-bit multiply: (int64_t)(z*z) * 0x4307a7LL
-    __m256i z_z_lo256 = _mm512_extracti32x8_epi32(z_z, 0);
-    __m256i z_z_hi256 = _mm512_extracti32x8_epi32(z_z, 1);
-    __m512i z_z_lo64 = _mm512_cvtepi32_epi64(z_z_lo256);
-    __m512i z_z_hi64 = _mm512_cvtepi32_epi64(z_z_hi256);
-    __m512i term3_lo = _mm512_mullo_epi64(z_z_lo64, _mm512_set1_epi64(0x4307a7));
-    __m512i term3_hi = _mm512_mullo_epi64(z_z_hi64, _mm512_set1_epi64(0x4307a7));
-    
-    // Store intermediate results
-    alignas(64) int32_t term1_arr[16], term2_arr[16], term4_arr[16];
-    alignas(64) int64_t term3_lo_arr[8], term3_hi_arr[8];
-    
-    _mm512_store_si512((__m512i*)term1_arr, term1);
-    _mm512_store_si512((__m512i*)term2_arr, term2);
-    _mm512_store_si512((__m512i*)term4_arr, term4);
-    _mm512_store_si512((__m512i*)term3_lo_arr, term3_lo);
-    _mm512_store_si512((__m512i*)term3_hi_arr, term3_hi);
-    
-    // Process all 16 chunks
-    for (int i = 0; i < 16; i++) {
-        int64_t t1 = (int64_t)term1_arr[i];
-        int64_t t2 = (int64_t)term2_arr[i];
-        int64_t t3 = (i < 8) ? term3_lo_arr[i] : term3_hi_arr[i - 8];
-        int64_t t4 = (int64_t)term4_arr[i];
-        
-        int64_t seed = worldSeed + t1 + t2 + t3 + t4 ^ 0x3ad8025fLL;
-        seed = (seed ^ 0x5DEECE66DULL) & 0xFFFFFFFFFFFFULL;
-        seed = (seed * 0x5DEECE66DULL + 0xBULL) & 0xFFFFFFFFFFFFULL;
-        int32_t bits = (int32_t)(seed >> 17);
+    const __m512i seedVec = _mm512_set1_epi64(worldSeed);
+    const __m512i c3 = _mm512_set1_epi64(0x4307a7);
+    
+    __m512i seedLo = _mm512_add_epi64(seedVec, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(term1, 0)));
+    __m512i seedHi = _mm512_add_epi64(seedVec, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(term1, 1)));
+    seedLo = _mm512_add_epi64(seedLo, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(term2, 0)));
+    seedHi = _mm512_add_epi64(seedHi, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(term2, 1)));
+    seedLo = _mm512_add_epi64(seedLo, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(term4, 0)));
+    seedHi = _mm512_add_epi64(seedHi, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(term4, 1)));
+    seedLo = _mm512_add_epi64(seedLo, _mm512_mullo_epi64(_mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(z_z, 0)), c3));
+    seedHi = _mm512_add_epi64(seedHi, _mm512_mullo_epi64(_mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(z_z, 1)), c3));
+    
+    return slimeSeedTailVec16(seedLo, seedHi);
+}
+
+// AVX-512 row sweep for chunks [startChunkX, startChunkX + count) at a fixed chunkZ.
+// The Z terms are folded into one 64-bit row base. The X terms advance by finite
+// differences in wrapping 32-bit lanes, which matches the int32 overflow of
+// isSlimeChunk exactly:
+//   x*x*c1: A(x+16) = A(x) + D(x), D(x) = c1*(32x + 256), D(x+16) = D(x) + 512*c1
+//   x*c2:   B(x+16) = B(x) + 16*c2
+// so there are no multiplies before the LCG. Results are written LSB-first into
+// rowBits, which must hold at least ceil(count / 64) words.
+SLIME_TARGET_AVX512 void isSlimeChunkRowVec16(int64_t startChunkX, int64_t chunkZ, int64_t count, int64_t worldSeed, uint64_t* rowBits) {
+    const uint32_t c1 = 0x4c1906;
+    const uint32_t c2 = 0x5ac0db;
+    
+    uint32_t z = (uint32_t)(int32_t)chunkZ;
+    int64_t rowBase = worldSeed +
+                      (int64_t)(int32_t)(z * z) * 0x4307a7LL +
+                      (int64_t)(int32_t)(z * 0x5f24fu);
+    
+    // Per-lane starting values (one set of multiplies per row)
+    __m512i x = _mm512_add_epi32(_mm512_set1_epi32((int32_t)(uint32_t)startChunkX),
+                                 _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    __m512i termA = _mm512_mullo_epi32(_mm512_mullo_epi32(x, x), _mm512_set1_epi32((int32_t)c1));
+    __m512i termB = _mm512_mullo_epi32(x, _mm512_set1_epi32((int32_t)c2));
+    __m512i deltaA = _mm512_mullo_epi32(_mm512_add_epi32(_mm512_slli_epi32(x, 5), _mm512_set1_epi32(256)),
+                                        _mm512_set1_epi32((int32_t)c1));
+    const __m512i deltaDeltaA = _mm512_set1_epi32((int32_t)(512 * c1));
+    const __m512i deltaB = _mm512_set1_epi32((int32_t)(16 * c2));
+    const __m512i baseVec = _mm512_set1_epi64(rowBase);
+    
+    uint64_t word = 0;
+    int64_t batches = (count + 15) / 16;
+    
+    for (int64_t b = 0; b < batches; b++) {
+        __m512i seedLo = _mm512_add_epi64(baseVec, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(termA, 0)));
+        __m512i seedHi = _mm512_add_epi64(baseVec, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(termA, 1)));
+        seedLo = _mm512_add_epi64(seedLo, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(termB, 0)));
+        seedHi = _mm512_add_epi64(seedHi, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(termB, 1)));
+        
+        uint64_t mask = slimeSeedTailVec16(seedLo, seedHi);
+        word |= mask << (16 * (b & 3));
+        
+        if ((b & 3) == 3) {
+            rowBits[b >> 2] = word;
+            word = 0;
+        }
+        
+        termA = _mm512_add_epi32(termA, deltaA);
+        deltaA = _mm512_add_epi32(deltaA, deltaDeltaA);
+        termB = _mm512_add_epi32(termB, deltaB);
+    }
+    
+    if (batches & 3) {
+        rowBits[batches >> 2] = word;
+    }
+    
+    // Clear lanes past the end of the row
+    if (count & 63) {
+        rowBits[count >> 6] &= (1ULL << (count & 63)) - 1;
+    }
+}
+
+// AVX-512 batch fill: 16-lane coordinate batches, four masks packed per grid word
+SLIME_TARGET_AVX512 static void fillRowBatchVec16(int64_t startChunkX, int64_t chunkZ, int64_t count, int64_t worldSeed, uint64_t* rowBits) {
+    alignas(64) int64_t chunkXBatch[16];
+    alignas(64) int64_t chunkZBatch[16];
+    uint64_t word = 0;
+    
+    for (int64_t i = 0; i < 16; i++) {
+        chunkZBatch[i] = chunkZ;
+    }
+    
+    for (int64_t x = 0; x < count; x += 16) {
+        for (int64_t i = 0; i < 16; i++) {
+            chunkXBatch[i] = startChunkX + x + i;
+        }
+        
+        uint64_t slimeMask = isSlimeChunkVec16(chunkXBatch, chunkZBatch, worldSeed);
+        word |= slimeMask << (x & 63);
+        
+        if ((x & 63) == 48) {
+            rowBits[x >> 6] = word;
+            word = 0;
+        }
+    }
+    
+    // Partial last word, dropping lanes past the end of the row
+    if ((count + 15) / 16 & 3) {
+        rowBits[(count - 1) >> 6] = word;
+    }
+    if (count & 63) {
+        rowBits[count >> 6] &= (1ULL << (count & 63)) - 1;
+    }
+}
+
+// AVX-512 multi-seed row fill. The polynomial terms don't depend on the world seed, so
+// each 64-chunk word is swept once (same finite differences as isSlimeChunkRowVec16,
+// with the seed left out of the row base) and only the tail runs per seed. Row k of
+// rowBits receives worldSeeds[k].
+SLIME_TARGET_AVX512 static void fillRowMultiSeedVec16(int64_t startChunkX, int64_t chunkZ, int64_t count,
+                                                      const int64_t* worldSeeds, int64_t seedCount,
+                                                      uint64_t* const* rowBits) {
+    const uint32_t c1 = 0x4c1906;
+    const uint32_t c2 = 0x5ac0db;
+    
+    uint32_t z = (uint32_t)(int32_t)chunkZ;
+    int64_t rowBase = (int64_t)(int32_t)(z * z) * 0x4307a7LL +
+                      (int64_t)(int32_t)(z * 0x5f24fu);
+    
+    __m512i x = _mm512_add_epi32(_mm512_set1_epi32((int32_t)(uint32_t)startChunkX),
+                                 _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    __m512i termA = _mm512_mullo_epi32(_mm512_mullo_epi32(x, x), _mm512_set1_epi32((int32_t)c1));
+    __m512i termB = _mm512_mullo_epi32(x, _mm512_set1_epi32((int32_t)c2));
+    __m512i deltaA = _mm512_mullo_epi32(_mm512_add_epi32(_mm512_slli_epi32(x, 5), _mm512_set1_epi32(256)),
+                                        _mm512_set1_epi32((int32_t)c1));
+    const __m512i deltaDeltaA = _mm512_set1_epi32((int32_t)(512 * c1));
+    const __m512i deltaB = _mm512_set1_epi32((int32_t)(16 * c2));
+    const __m512i baseVec = _mm512_set1_epi64(rowBase);
+    
+    int64_t words = (count + 63) / 64;
+    for (int64_t w = 0; w < words; w++) {
+        // Seed-independent part of the word's 64 chunks
+        __m512i polyLo[4], polyHi[4];
+        for (int q = 0; q < 4; q++) {
+            polyLo[q] = _mm512_add_epi64(baseVec, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(termA, 0)));
+            polyHi[q] = _mm512_add_epi64(baseVec, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(termA, 1)));
+            polyLo[q] = _mm512_add_epi64(polyLo[q], _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(termB, 0)));
+            polyHi[q] = _mm512_add_epi64(polyHi[q], _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(termB, 1)));
+            
+            termA = _mm512_add_epi32(termA, deltaA);
+            deltaA = _mm512_add_epi32(deltaA, deltaDeltaA);
+            termB = _mm512_add_epi32(termB, deltaB);
+        }
+        
+        for (int64_t k = 0; k < seedCount; k++) {
+            const __m512i seedVec = _mm512_set1_epi64(worldSeeds[k]);
+            uint64_t word = 0;
+            for (int q = 0; q < 4; q++) {
+                uint64_t mask = slimeSeedTailVec16(_mm512_add_epi64(polyLo[q], seedVec),
+                                                   _mm512_add_epi64(polyHi[q], seedVec));
+                word |= mask << (16 * q);
+            }
+            rowBits[k][w] = word;
+        }
+    }
+    
+    if (count & 63) {
+        for (int64_t k = 0; k < seedCount; k++) {
+            rowBits[k][count >> 6] &= (1ULL << (count & 63)) - 1;
+        }
+    }
+}
+
+// AVX2 SLIME CHUNK DETECTION
+
+// Low 48 bits of seed * 0x5DEECE66D + 0xB in 4x64-bit lanes. AVX2 has no 64-bit
+// multiply, so it is built from 32x32->64 products:
+//   lo(s)*lo(M) + ((hi(s)*lo(M) + lo(s)*hi(M)) << 32)
+SLIME_TARGET_AVX2 static inline __m256i lcgStepVec4(__m256i seed) {
+    const __m256i multiplierLo = _mm256_set1_epi64x(0xDEECE66DLL);
+    const __m256i multiplierHi = _mm256_set1_epi64x(0x5LL);
+    const __m256i addend = _mm256_set1_epi64x(0xBLL);
+    const __m256i mask48 = _mm256_set1_epi64x(0xFFFFFFFFFFFFLL);
+    
+    __m256i low = _mm256_mul_epu32(seed, multiplierLo);
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(seed, 32), multiplierLo),
+                                     _mm256_mul_epu32(seed, multiplierHi));
+    __m256i product = _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+    return _mm256_and_si256(_mm256_add_epi64(product, addend), mask48);
+}
+
+// Gather the low 32 bits of the 8 lanes held in two 4x64-bit registers into one register
+SLIME_TARGET_AVX2 static inline __m256i packLow32Vec8(__m256i lo, __m256i hi) {
+    const __m256i evenFirst = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    __m256i packedLo = _mm256_permutevar8x32_epi32(lo, evenFirst);
+    __m256i packedHi = _mm256_permutevar8x32_epi32(hi, evenFirst);
+    return _mm256_permute2x128_si256(packedLo, packedHi, 0x20);
+}
+
+// 8-lane counterpart of slimeSeedTailVec16
+SLIME_TARGET_AVX2 static inline uint8_t slimeSeedTailVec8(__m256i seedLo, __m256i seedHi) {
+    const __m256i scramble = _mm256_set1_epi64x(0x3ad8025fLL ^ 0x5DEECE66DLL);
+    
+    seedLo = lcgStepVec4(_mm256_xor_si256(seedLo, scramble));
+    seedHi = lcgStepVec4(_mm256_xor_si256(seedHi, scramble));
+    
+    __m256i bits = packLow32Vec8(_mm256_srli_epi64(seedLo, 17), _mm256_srli_epi64(seedHi, 17));
+    
+    // Same divisibility test as the AVX-512 tail. There is no unsigned compare, so
+    // a <= b is checked as min(a, b) == a.
+    const __m256i limit = _mm256_set1_epi32(0x19999999);
+    __m256i scaled = _mm256_mullo_epi32(bits, _mm256_set1_epi32((int32_t)0xCCCCCCCDu));
+    __m256i rotated = _mm256_or_si256(_mm256_srli_epi32(scaled, 1), _mm256_slli_epi32(scaled, 31));
+    __m256i divisible = _mm256_cmpeq_epi32(_mm256_min_epu32(rotated, limit), rotated);
+    return (uint8_t)_mm256_movemask_ps(_mm256_castsi256_ps(divisible));
+}
+
+// AVX2 slime chunk detection for 8 chunks. Bit i of the result is set when chunk i is
+// a slime chunk.
+SLIME_TARGET_AVX2 uint8_t isSlimeChunkVec8(const int64_t* chunkX, const int64_t* chunkZ, int64_t worldSeed) {
+    __m256i x = packLow32Vec8(_mm256_loadu_si256((const __m256i*)chunkX),
+                              _mm256_loadu_si256((const __m256i*)(chunkX + 4)));
+    __m256i z = packLow32Vec8(_mm256_loadu_si256((const __m256i*)chunkZ),
+                              _mm256_loadu_si256((const __m256i*)(chunkZ + 4)));
+    
+    __m256i x_x = _mm256_mullo_epi32(x, x);
+    __m256i z_z = _mm256_mullo_epi32(z, z);
+    
+    // Each 32-bit term wraps on its own in isSlimeChunk, so widen them separately
+    __m256i term1 = _mm256_mullo_epi32(x_x, _mm256_set1_epi32(0x4c1906));
+    __m256i term2 = _mm256_mullo_epi32(x, _mm256_set1_epi32(0x5ac0db));
+    __m256i term4 = _mm256_mullo_epi32(z, _mm256_set1_epi32(0x5f24f));
+    
+    const __m256i seedVec = _mm256_set1_epi64x(worldSeed);
+    const __m256i c3 = _mm256_set1_epi64x(0x4307a7);
+    
+    __m256i seedLo = _mm256_add_epi64(seedVec, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(term1)));
+    __m256i seedHi = _mm256_add_epi64(seedVec, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(term1, 1)));
+    seedLo = _mm256_add_epi64(seedLo, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(term2)));
+    seedHi = _mm256_add_epi64(seedHi, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(term2, 1)));
+    seedLo = _mm256_add_epi64(seedLo, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(term4)));
+    seedHi = _mm256_add_epi64(seedHi, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(term4, 1)));
+    // (int64_t)(z*z) * 0x4307a7: signed 32x32->64 multiply of the low halves
+    seedLo = _mm256_add_epi64(seedLo, _mm256_mul_epi32(_mm256_cvtepi32_epi64(_mm256_castsi256_si128(z_z)), c3));
+    seedHi = _mm256_add_epi64(seedHi, _mm256_mul_epi32(_mm256_cvtepi32_epi64(_mm256_extracti128_si256(z_z, 1)), c3));
+    
+    return slimeSeedTailVec8(seedLo, seedHi);
+}
+
+// AVX2 row sweep, the 8-lane version of isSlimeChunkRowVec16:
+//   x*x*c1: A(x+8) = A(x) + D(x), D(x) = c1*(16x + 64), D(x+8) = D(x) + 128*c1
+//   x*c2:   B(x+8) = B(x) + 8*c2
+SLIME_TARGET_AVX2 void isSlimeChunkRowVec8(int64_t startChunkX, int64_t chunkZ, int64_t count, int64_t worldSeed, uint64_t* rowBits) {
+    const uint32_t c1 = 0x4c1906;
+    const uint32_t c2 = 0x5ac0db;
+    
+    uint32_t z = (uint32_t)(int32_t)chunkZ;
+    int64_t rowBase = worldSeed +
+                      (int64_t)(int32_t)(z * z) * 0x4307a7LL +
+                      (int64_t)(int32_t)(z * 0x5f24fu);
+    
+    __m256i x = _mm256_add_epi32(_mm256_set1_epi32((int32_t)(uint32_t)startChunkX),
+                                 _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256i termA = _mm256_mullo_epi32(_mm256_mullo_epi32(x, x), _mm256_set1_epi32((int32_t)c1));
+    __m256i termB = _mm256_mullo_epi32(x, _mm256_set1_epi32((int32_t)c2));
+    __m256i deltaA = _mm256_mullo_epi32(_mm256_add_epi32(_mm256_slli_epi32(x, 4), _mm256_set1_epi32(64)),
+                                        _mm256_set1_epi32((int32_t)c1));
+    const __m256i deltaDeltaA = _mm256_set1_epi32((int32_t)(128 * c1));
+    const __m256i deltaB = _mm256_set1_epi32((int32_t)(8 * c2));
+    const __m256i baseVec = _mm256_set1_epi64x(rowBase);
+    
+    uint64_t word = 0;
+    int64_t batches = (count + 7) / 8;
+    
+    for (int64_t b = 0; b < batches; b++) {
+        __m256i seedLo = _mm256_add_epi64(baseVec, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(termA)));
+        __m256i seedHi = _mm256_add_epi64(baseVec, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(termA, 1)));
+        seedLo = _mm256_add_epi64(seedLo, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(termB)));
+        seedHi = _mm256_add_epi64(seedHi, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(termB, 1)));
+        
+        uint64_t mask = slimeSeedTailVec8(seedLo, seedHi);
+        word |= mask << (8 * (b & 7));
+        
+        if ((b & 7) == 7) {
+            rowBits[b >> 3] = word;
+            word = 0;
+        }
         
-        results[i] = (bits % 10) == 0;
+        termA = _mm256_add_epi32(termA, deltaA);
+        deltaA = _mm256_add_epi32(deltaA, deltaDeltaA);
+        termB = _mm256_add_epi32(termB, deltaB);
+    }
+    
+    if (batches & 7) {
+        rowBits[batches >> 3] = word;
+    }
+    
+    if (count & 63) {
+        rowBits[count >> 6] &= (1ULL << (count & 63)) - 1;
+    }
+}
+
+// AVX2 batch fill: 8-lane coordinate batches, eight masks packed per grid word
+SLIME_TARGET_AVX2 static void fillRowBatchVec8(int64_t startChunkX, int64_t chunkZ, int64_t count, int64_t worldSeed, uint64_t* rowBits) {
+    alignas(32) int64_t chunkXBatch[8];
+    alignas(32) int64_t chunkZBatch[8];
+    uint64_t word = 0;
+    
+    for (int64_t i = 0; i < 8; i++) {
+        chunkZBatch[i] = chunkZ;
+    }
+    
+    for (int64_t x = 0; x < count; x += 8) {
+        for (int64_t i = 0; i < 8; i++) {
+            chunkXBatch[i] = startChunkX + x + i;
+        }
+        
+        uint64_t slimeMask = isSlimeChunkVec8(chunkXBatch, chunkZBatch, worldSeed);
+        word |= slimeMask << (x & 63);
+        
+        if ((x & 63) == 56) {
+            rowBits[x >> 6] = word;
+            word = 0;
+        }
+    }
+    
+    if ((count + 7) / 8 & 7) {
+        rowBits[(count - 1) >> 6] = word;
+    }
+    if (count & 63) {
+        rowBits[count >> 6] &= (1ULL << (count & 63)) - 1;
+    }
+}
+
+// AVX2 multi-seed row fill, the 8-lane version of fillRowMultiSeedVec16
+SLIME_TARGET_AVX2 static void fillRowMultiSeedVec8(int64_t startChunkX, int64_t chunkZ, int64_t count,
+                                                   const int64_t* worldSeeds, int64_t seedCount,
+                                                   uint64_t* const* rowBits) {
+    const uint32_t c1 = 0x4c1906;
+    const uint32_t c2 = 0x5ac0db;
+    
+    uint32_t z = (uint32_t)(int32_t)chunkZ;
+    int64_t rowBase = (int64_t)(int32_t)(z * z) * 0x4307a7LL +
+                      (int64_t)(int32_t)(z * 0x5f24fu);
+    
+    __m256i x = _mm256_add_epi32(_mm256_set1_epi32((int32_t)(uint32_t)startChunkX),
+                                 _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256i termA = _mm256_mullo_epi32(_mm256_mullo_epi32(x, x), _mm256_set1_epi32((int32_t)c1));
+    __m256i termB = _mm256_mullo_epi32(x, _mm256_set1_epi32((int32_t)c2));
+    __m256i deltaA = _mm256_mullo_epi32(_mm256_add_epi32(_mm256_slli_epi32(x, 4), _mm256_set1_epi32(64)),
+                                        _mm256_set1_epi32((int32_t)c1));
+    const __m256i deltaDeltaA = _mm256_set1_epi32((int32_t)(128 * c1));
+    const __m256i deltaB = _mm256_set1_epi32((int32_t)(8 * c2));
+    const __m256i baseVec = _mm256_set1_epi64x(rowBase);
+    
+    int64_t words = (count + 63) / 64;
+    for (int64_t w = 0; w < words; w++) {
+        __m256i polyLo[8], polyHi[8];
+        for (int q = 0; q < 8; q++) {
+            polyLo[q] = _mm256_add_epi64(baseVec, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(termA)));
+            polyHi[q] = _mm256_add_epi64(baseVec, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(termA, 1)));
+            polyLo[q] = _mm256_add_epi64(polyLo[q], _mm256_cvtepi32_epi64(_mm256_castsi256_si128(termB)));
+            polyHi[q] = _mm256_add_epi64(polyHi[q], _mm256_cvtepi32_epi64(_mm256_extracti128_si256(termB, 1)));
+            
+            termA = _mm256_add_epi32(termA, deltaA);
+            deltaA = _mm256_add_epi32(deltaA, deltaDeltaA);
+            termB = _mm256_add_epi32(termB, deltaB);
+        }
+        
+        for (int64_t k = 0; k < seedCount; k++) {
+            const __m256i seedVec = _mm256_set1_epi64x(worldSeeds[k]);
+            uint64_t word = 0;
+            for (int q = 0; q < 8; q++) {
+                uint64_t mask = slimeSeedTailVec8(_mm256_add_epi64(polyLo[q], seedVec),
+                                                  _mm256_add_epi64(polyHi[q], seedVec));
+                word |= mask << (8 * q);
+            }
+            rowBits[k][w] = word;
+        }
+    }
+    
+    if (count & 63) {
+        for (int64_t k = 0; k < seedCount; k++) {
+            rowBits[k][count >> 6] &= (1ULL << (count & 63)) - 1;
+        }
     }
 }
 
+// SCALAR SLIME CHUNK DETECTION
+
 // Scalar slime chunk detection.
 // Only bits [17..47] of the final seed matter for divisibility check.
 bool isSlimeChunk(int64_t chunkX, int64_t chunkZ, int64_t worldSeed) {
@@ -121,288 +613,2788 @@ inline bool isSlimeChunkFast(int64_t chunkX, int64_t chunkZ, int64_t worldSeed)
     return isDivisibleBy10(bits);
 }
 
-// RECTANGLE STRUCTURE
-bool Rectangle::operator<(const Rectangle& other) const {
-    // Sort by area (largest first)
-    if (area != other.area) return area > other.area;
+// Scalar row sweep with the same finite differences as the vector kernels, one chunk
+// per step:
+//   x*x*c1: A(x+1) = A(x) + D(x), D(x) = c1*(2x + 1), D(x+1) = D(x) + 2*c1
+//   x*c2:   B(x+1) = B(x) + c2
+void isSlimeChunkRowScalar(int64_t startChunkX, int64_t chunkZ, int64_t count, int64_t worldSeed, uint64_t* rowBits) {
+    const uint32_t c1 = 0x4c1906;
+    const uint32_t c2 = 0x5ac0db;
     
-    // Sort by distance from spawn (closest first)
-    if (distanceSquared != other.distanceSquared) return distanceSquared < other.distanceSquared;
+    uint32_t z = (uint32_t)(int32_t)chunkZ;
+    int64_t rowBase = worldSeed +
+                      (int64_t)(int32_t)(z * z) * 0x4307a7LL +
+                      (int64_t)(int32_t)(z * 0x5f24fu);
     
-    // Consistent ordering by coordinates
-    if (x != other.x) return x < other.x;
-    return z < other.z;
+    uint32_t x = (uint32_t)startChunkX;
+    uint32_t termA = x * x * c1;
+    uint32_t termB = x * c2;
+    uint32_t deltaA = (2 * x + 1) * c1;
+    uint64_t word = 0;
+    
+    for (int64_t i = 0; i < count; i++) {
+        uint64_t seed = (uint64_t)(rowBase + (int64_t)(int32_t)termA + (int64_t)(int32_t)termB);
+        seed ^= 0x3ad8025fULL ^ 0x5DEECE66DULL;
+        seed = (seed * 0x5DEECE66DULL + 0xBULL) & 0xFFFFFFFFFFFFULL;
+        
+        if ((uint32_t)(seed >> 17) % 10 == 0) {
+            word |= 1ULL << (i & 63);
+        }
+        if ((i & 63) == 63) {
+            rowBits[i >> 6] = word;
+            word = 0;
+        }
+        
+        termA += deltaA;
+        deltaA += 2 * c1;
+        termB += c2;
+    }
+    
+    if (count & 63) {
+        rowBits[count >> 6] = word;
+    }
 }
 
-// RECTANGLE FINDING
+// Scalar batch fill: one isSlimeChunk call per chunk
+static void fillRowBatchScalar(int64_t startChunkX, int64_t chunkZ, int64_t count, int64_t worldSeed, uint64_t* rowBits) {
+    std::memset(rowBits, 0, (size_t)((count + 63) / 64) * sizeof(uint64_t));
+    for (int64_t x = 0; x < count; x++) {
+        if (isSlimeChunk(startChunkX + x, chunkZ, worldSeed)) {
+            rowBits[x >> 6] |= 1ULL << (x & 63);
+        }
+    }
+}
 
-// Maximal rectangle detection using histogram algorithm
-void findMaximalRectangles(const std::vector<std::vector<bool>>& grid, 
-                           int64_t startRow, int64_t endRow,
-                           int64_t offsetX, int64_t offsetZ,
-                           int64_t minimumRectDimension,
-                           std::mutex& resultsMutex,
-                           std::set<Rectangle>& foundRectangles,
-                           bool debugMode) {
+// Scalar multi-seed row fill: the row sweep's polynomial for 64 chunks at a time, then
+// the tail for every seed
+static void fillRowMultiSeedScalar(int64_t startChunkX, int64_t chunkZ, int64_t count,
+                                   const int64_t* worldSeeds, int64_t seedCount,
+                                   uint64_t* const* rowBits) {
+    const uint32_t c1 = 0x4c1906;
+    const uint32_t c2 = 0x5ac0db;
     
-    if (grid.empty()) return;
+    uint32_t z = (uint32_t)(int32_t)chunkZ;
+    int64_t rowBase = (int64_t)(int32_t)(z * z) * 0x4307a7LL +
+                      (int64_t)(int32_t)(z * 0x5f24fu);
     
-    int64_t rows = endRow - startRow;
-    int64_t cols = grid[0].size();
+    uint32_t x = (uint32_t)startChunkX;
+    uint32_t termA = x * x * c1;
+    uint32_t termB = x * c2;
+    uint32_t deltaA = (2 * x + 1) * c1;
+    int64_t poly[64];
     
-    if (debugMode) {
-        bool isTestRegion = (offsetX <= 1495 && offsetX + cols > 1495 && 
-                             offsetZ <= 8282 && offsetZ + rows > 8282);
-        if (isTestRegion) {
-            std::lock_guard<std::mutex> lock(resultsMutex);
-            std::cout << "[DEBUG] findMaximalRectangles called: offsetX=" << offsetX 
-                      << " offsetZ=" << offsetZ << " rows=" << rows << " cols=" << cols << "\n";
+    for (int64_t base = 0; base < count; base += 64) {
+        int64_t chunks = std::min<int64_t>(64, count - base);
+        for (int64_t i = 0; i < chunks; i++) {
+            poly[i] = rowBase + (int64_t)(int32_t)termA + (int64_t)(int32_t)termB;
+            termA += deltaA;
+            deltaA += 2 * c1;
+            termB += c2;
+        }
+        
+        for (int64_t k = 0; k < seedCount; k++) {
+            uint64_t word = 0;
+            for (int64_t i = 0; i < chunks; i++) {
+                uint64_t seed = (uint64_t)(worldSeeds[k] + poly[i]);
+                seed ^= 0x3ad8025fULL ^ 0x5DEECE66DULL;
+                seed = (seed * 0x5DEECE66DULL + 0xBULL) & 0xFFFFFFFFFFFFULL;
+                if ((uint32_t)(seed >> 17) % 10 == 0) {
+                    word |= 1ULL << i;
+                }
+            }
+            rowBits[k][base >> 6] = word;
+        }
+    }
+}
+
+// HISTOGRAM HEIGHT KERNELS
+// One row step of the rectangle stage: +1 where the row is set, 0 elsewhere. Each also
+// reports whether any height reached threshold, so rows where nothing is tall enough
+// can skip the histogram scan.
+
+// 32 columns per step: the row's mask bits drive a zero-masked 16-bit add
+SLIME_TARGET_AVX512 static bool updateHeightsVec32(uint16_t* heights, const uint64_t* rowBits, int64_t cols, uint16_t threshold) {
+    const __m512i one = _mm512_set1_epi16(1);
+    const __m512i limit = _mm512_set1_epi16((short)threshold);
+    __mmask32 tall = 0;
+    
+    for (int64_t base = 0; base < cols; base += 32) {
+        __mmask32 bits = (__mmask32)(rowBits[base >> 6] >> (base & 63));
+        __m512i h = _mm512_maskz_add_epi16(bits, _mm512_loadu_si512(heights + base), one);
+        _mm512_storeu_si512(heights + base, h);
+        tall |= _mm512_cmpge_epu16_mask(h, limit);
+    }
+    return tall != 0;
+}
+
+// 16 columns per step. AVX2 has no mask registers, so the 16 row bits are broadcast
+// and turned into a lane mask by testing one bit per lane.
+SLIME_TARGET_AVX2 static bool updateHeightsVec16(uint16_t* heights, const uint64_t* rowBits, int64_t cols, uint16_t threshold) {
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i limit = _mm256_set1_epi16((short)threshold);
+    const __m256i laneBit = _mm256_setr_epi16(0x0001, 0x0002, 0x0004, 0x0008, 0x0010, 0x0020, 0x0040, 0x0080,
+                                              0x0100, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000, 0x4000, (short)0x8000);
+    __m256i tall = _mm256_setzero_si256();
+    
+    for (int64_t base = 0; base < cols; base += 16) {
+        __m256i bits = _mm256_set1_epi16((short)(rowBits[base >> 6] >> (base & 63)));
+        __m256i set = _mm256_cmpeq_epi16(_mm256_and_si256(bits, laneBit), laneBit);
+        __m256i h = _mm256_loadu_si256((const __m256i*)(heights + base));
+        h = _mm256_and_si256(_mm256_add_epi16(h, one), set);
+        _mm256_storeu_si256((__m256i*)(heights + base), h);
+        // Unsigned h >= limit
+        tall = _mm256_or_si256(tall, _mm256_cmpeq_epi16(_mm256_max_epu16(h, limit), h));
+    }
+    return !_mm256_testz_si256(tall, tall);
+}
+
+// Whole empty and whole full words are the common cases and skip the per-bit work
+static bool updateHeightsScalar(uint16_t* heights, const uint64_t* rowBits, int64_t cols, uint16_t threshold) {
+    bool tall = false;
+    for (int64_t base = 0; base < cols; base += 64) {
+        uint64_t word = rowBits[base >> 6];
+        int64_t count = std::min<int64_t>(64, cols - base);
+        uint16_t* h = heights + base;
+        
+        if (word == 0) {
+            std::memset(h, 0, count * sizeof(uint16_t));
+        } else if (word == ~0ULL) {
+            for (int64_t k = 0; k < count; k++) {
+                h[k]++;
+                tall |= h[k] >= threshold;
+            }
+        } else {
+            for (int64_t k = 0; k < count; k++) {
+                h[k] = (uint16_t)((h[k] + 1) & (0 - ((word >> k) & 1)));
+                tall |= h[k] >= threshold;
+            }
+        }
+    }
+    return tall;
+}
+
+// KERNEL DISPATCH
+static void cpuidQuery(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuidex(info, (int)leaf, (int)subleaf);
+    for (int i = 0; i < 4; i++) {
+        regs[i] = (uint32_t)info[i];
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// XCR0: which register states the OS saves on a context switch
+static uint64_t readXcr0() {
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t)edx << 32) | eax;
+#endif
+}
+
+SimdLevel detectSimdLevel() {
+    static const SimdLevel level = [] {
+        uint32_t regs[4];
+        cpuidQuery(0, 0, regs);
+        uint32_t maxLeaf = regs[0];
+        if (maxLeaf < 7) {
+            return SimdLevel::Scalar;
+        }
+        
+        // OSXSAVE and AVX (leaf 1 ECX bits 27, 28), with XMM/YMM state enabled
+        cpuidQuery(1, 0, regs);
+        if ((regs[2] & (3u << 27)) != (3u << 27)) {
+            return SimdLevel::Scalar;
+        }
+        uint64_t xcr0 = readXcr0();
+        if ((xcr0 & 0x6) != 0x6) {
+            return SimdLevel::Scalar;
+        }
+        
+        cpuidQuery(7, 0, regs);
+        bool avx2 = (regs[1] >> 5) & 1;
+        bool avx512 = ((regs[1] >> 16) & 1) && ((regs[1] >> 17) & 1) && ((regs[1] >> 30) & 1);   // F, DQ and BW
+        
+        // AVX-512 additionally needs the opmask and upper ZMM states
+        if (avx512 && (xcr0 & 0xE6) == 0xE6) {
+            return SimdLevel::AVX512;
+        }
+        return avx2 ? SimdLevel::AVX2 : SimdLevel::Scalar;
+    }();
+    return level;
+}
+
+static const SlimeKernel slimeKernels[] = {
+    { SimdLevel::Scalar, "Scalar (SSE2 baseline)", fillRowBatchScalar, isSlimeChunkRowScalar, fillRowMultiSeedScalar,
+      updateHeightsScalar },
+    { SimdLevel::AVX2,   "AVX2 8-wide",            fillRowBatchVec8,   isSlimeChunkRowVec8,   fillRowMultiSeedVec8,
+      updateHeightsVec16 },
+    { SimdLevel::AVX512, "AVX-512 16-wide",        fillRowBatchVec16,  isSlimeChunkRowVec16,  fillRowMultiSeedVec16,
+      updateHeightsVec32 },
+};
+
+const SlimeKernel& slimeKernelFor(SimdLevel level) {
+    return slimeKernels[(int)level];
+}
+
+bool verifySlimeKernel(const SlimeKernel& kernel, int64_t worldSeed) {
+    // Odd counts exercise partial words; the last rows straddle the int32 wrap in X and Z
+    const int64_t rows[][3] = {
+        { -300, -100, 517 },
+        { 12345, -67890, 333 },
+        { 2147483600LL, 5, 101 },
+        { -2147483700LL, 2147483640LL, 129 },
+        { 29999900, -29999990, 200 },
+    };
+    std::vector<uint64_t> rowBits;
+    
+    for (const auto& row : rows) {
+        int64_t startX = row[0], chunkZ = row[1], count = row[2];
+        
+        for (int fill = 0; fill < 2; fill++) {
+            rowBits.assign((size_t)((count + 63) / 64), ~0ULL);
+            if (fill == 0) {
+                kernel.fillRowBatch(startX, chunkZ, count, worldSeed, rowBits.data());
+            } else {
+                kernel.fillRowIncremental(startX, chunkZ, count, worldSeed, rowBits.data());
+            }
+            
+            for (int64_t i = 0; i < (int64_t)rowBits.size() * 64; i++) {
+                bool got = (rowBits[i >> 6] >> (i & 63)) & 1;
+                bool expected = i < count && isSlimeChunk(startX + i, chunkZ, worldSeed);
+                if (got != expected) {
+                    return false;
+                }
+            }
+        }
+        
+        // Multi-seed fill, with the seed itself and two unrelated ones
+        const int64_t seeds[3] = { worldSeed, ~worldSeed, worldSeed ^ 0x5DEECE66DLL };
+        std::vector<uint64_t> seedRows[3];
+        uint64_t* seedRowPtrs[3];
+        for (int k = 0; k < 3; k++) {
+            seedRows[k].assign((size_t)((count + 63) / 64), ~0ULL);
+            seedRowPtrs[k] = seedRows[k].data();
+        }
+        kernel.fillRowMultiSeed(startX, chunkZ, count, seeds, 3, seedRowPtrs);
+        for (int k = 0; k < 3; k++) {
+            for (int64_t i = 0; i < (int64_t)seedRows[k].size() * 64; i++) {
+                bool got = (seedRows[k][i >> 6] >> (i & 63)) & 1;
+                bool expected = i < count && isSlimeChunk(startX + i, chunkZ, seeds[k]);
+                if (got != expected) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// ENGINE SELECTION
+const char* gridEngineName(GridEngine engine) {
+    switch (engine) {
+        case GridEngine::Batch:          return "batch";
+        case GridEngine::RowIncremental: return "row";
+    }
+    return "unknown";
+}
+
+bool parseGridEngine(const std::string& name, GridEngine& engine) {
+    if (name == "batch") {
+        engine = GridEngine::Batch;
+    } else if (name == "row") {
+        engine = GridEngine::RowIncremental;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* rectFilterName(RectFilter filter) {
+    switch (filter) {
+        case RectFilter::None:      return "none";
+        case RectFilter::SquareAnd: return "square";
+    }
+    return "unknown";
+}
+
+bool parseRectFilter(const std::string& name, RectFilter& filter) {
+    if (name == "none") {
+        filter = RectFilter::None;
+    } else if (name == "square") {
+        filter = RectFilter::SquareAnd;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* rectModeName(RectMode mode) {
+    switch (mode) {
+        case RectMode::Exhaustive: return "all";
+        case RectMode::Maximal:    return "maximal";
+    }
+    return "unknown";
+}
+
+bool parseRectMode(const std::string& name, RectMode& mode) {
+    if (name == "all") {
+        mode = RectMode::Exhaustive;
+    } else if (name == "maximal") {
+        mode = RectMode::Maximal;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* searchModeName(SearchMode mode) {
+    switch (mode) {
+        case SearchMode::Exhaustive: return "exhaustive";
+        case SearchMode::Largest:    return "largest";
+    }
+    return "unknown";
+}
+
+bool parseSearchMode(const std::string& name, SearchMode& mode) {
+    if (name == "exhaustive") {
+        mode = SearchMode::Exhaustive;
+    } else if (name == "largest") {
+        mode = SearchMode::Largest;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* tilingName(Tiling tiling) {
+    switch (tiling) {
+        case Tiling::Padded: return "padded";
+        case Tiling::Seams:  return "seams";
+    }
+    return "unknown";
+}
+
+bool parseTiling(const std::string& name, Tiling& tiling) {
+    if (name == "padded") {
+        tiling = Tiling::Padded;
+    } else if (name == "seams") {
+        tiling = Tiling::Seams;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* schedulerName(Scheduler scheduler) {
+    switch (scheduler) {
+        case Scheduler::Shared:   return "shared";
+        case Scheduler::Stealing: return "stealing";
+    }
+    return "unknown";
+}
+
+bool parseScheduler(const std::string& name, Scheduler& scheduler) {
+    if (name == "shared") {
+        scheduler = Scheduler::Shared;
+    } else if (name == "stealing") {
+        scheduler = Scheduler::Stealing;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::AVX2:   return "avx2";
+        case SimdLevel::AVX512: return "avx512";
+    }
+    return "unknown";
+}
+
+bool parseSimdLevel(const std::string& name, SimdLevel& level) {
+    if (name == "scalar") {
+        level = SimdLevel::Scalar;
+    } else if (name == "avx2") {
+        level = SimdLevel::AVX2;
+    } else if (name == "avx512") {
+        level = SimdLevel::AVX512;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// STAGE METRICS
+static thread_local StageCounters* threadStageCounters = nullptr;
+
+void bindStageCounters(StageCounters* counters) {
+    threadStageCounters = counters;
+}
+
+// Single writer, so no locked instruction is needed
+static inline void bumpCounter(std::atomic<uint64_t>& counter, uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+// Scoped exclusive timer. Starting one charges the enclosing timer up to now and pauses
+// it; ending one resumes the enclosing timer. Without bound counters it costs a
+// thread_local load and a branch.
+class StageTimer {
+public:
+    explicit StageTimer(Stage stage) : counters(threadStageCounters), stage((int)stage) {
+        if (counters == nullptr) return;
+        start = __rdtsc();
+        outer = activeTimer;
+        if (outer != nullptr) {
+            bumpCounter(outer->counters->cycles[outer->stage], start - outer->start);
+        }
+        activeTimer = this;
+    }
+    ~StageTimer() {
+        if (counters == nullptr) return;
+        uint64_t now = __rdtsc();
+        bumpCounter(counters->cycles[stage], now - start);
+        bumpCounter(counters->calls[stage], 1);
+        activeTimer = outer;
+        if (outer != nullptr) {
+            outer->start = now;
+        }
+    }
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+private:
+    static thread_local StageTimer* activeTimer;
+    StageCounters* counters;
+    int stage;
+    uint64_t start = 0;
+    StageTimer* outer = nullptr;
+};
+
+thread_local StageTimer* StageTimer::activeTimer = nullptr;
+
+static inline void countStageEvent(std::atomic<uint64_t> StageCounters::*counter, uint64_t amount = 1) {
+    if (threadStageCounters != nullptr) {
+        bumpCounter(threadStageCounters->*counter, amount);
+    }
+}
+
+const char* stageName(Stage stage) {
+    switch (stage) {
+        case Stage::Fill:      return "fill";
+        case Stage::Filter:    return "filter";
+        case Stage::Heights:   return "heights";
+        case Stage::Extension: return "extension";
+        case Stage::Seams:     return "seams";
+        case Stage::Merge:     return "merge";
+        case Stage::LockWait:  return "lock_wait";
+        case Stage::Count:     break;
+    }
+    return "unknown";
+}
+
+StageMetrics::StageMetrics(int64_t threadCount)
+    : threads(std::max<int64_t>(threadCount, 1)), slots(new StageCounters[(size_t)std::max<int64_t>(threadCount, 1)]),
+      startTicks(__rdtsc()), startTime(std::chrono::steady_clock::now()) {
+    for (int64_t t = 0; t < threads; t++) {
+        StageCounters& slot = slots[t];
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            slot.cycles[i].store(0, std::memory_order_relaxed);
+            slot.calls[i].store(0, std::memory_order_relaxed);
+        }
+        slot.rectangles.store(0, std::memory_order_relaxed);
+        slot.deferredMerges.store(0, std::memory_order_relaxed);
+        slot.arenaAllocations.store(0, std::memory_order_relaxed);
+    }
+}
+
+StageMetrics::Totals StageMetrics::total() const {
+    Totals totals;
+    for (int64_t t = 0; t < threads; t++) {
+        const StageCounters& slot = slots[t];
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            totals.cycles[i] += slot.cycles[i].load(std::memory_order_relaxed);
+            totals.calls[i] += slot.calls[i].load(std::memory_order_relaxed);
+        }
+        totals.rectangles += slot.rectangles.load(std::memory_order_relaxed);
+        totals.deferredMerges += slot.deferredMerges.load(std::memory_order_relaxed);
+        totals.arenaAllocations += slot.arenaAllocations.load(std::memory_order_relaxed);
+    }
+    uint64_t ticks = stopTicks.load(std::memory_order_acquire);
+    int64_t nanoseconds = stopNanoseconds.load(std::memory_order_relaxed);
+    if (ticks == 0) {
+        ticks = __rdtsc() - startTicks;
+        nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+    }
+    totals.seconds = nanoseconds / 1e9;
+    totals.ticksPerSecond = (totals.seconds > 0) ? ticks / totals.seconds : 0;
+    return totals;
+}
+
+void StageMetrics::stop() {
+    uint64_t ticks = __rdtsc() - startTicks;
+    stopNanoseconds.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - startTime).count(), std::memory_order_relaxed);
+    stopTicks.store(std::max<uint64_t>(ticks, 1), std::memory_order_release);
+}
+
+std::string StageMetrics::breakdown() const {
+    Totals totals = total();
+    double available = totals.seconds * totals.ticksPerSecond * threads;
+    if (available <= 0) return "";
+    
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    double accounted = 0;
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        accounted += (double)totals.cycles[i];
+        out << stageName((Stage)i) << " " << 100.0 * totals.cycles[i] / available << "% | ";
+    }
+    out << "other " << std::max(0.0, 100.0 * (available - accounted) / available) << "%";
+    return out.str();
+}
+
+bool StageMetrics::write(const std::string& path, int64_t chunksProcessed, int64_t unitsCompleted) const {
+    Totals totals = total();
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+        out << std::setprecision(12);
+        out << "# HELP slimechunk_stage_seconds_total Time spent in each hot-path stage, summed over workers\n"
+            << "# TYPE slimechunk_stage_seconds_total counter\n";
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            out << "slimechunk_stage_seconds_total{stage=\"" << stageName((Stage)i) << "\"} "
+                << (totals.ticksPerSecond > 0 ? totals.cycles[i] / totals.ticksPerSecond : 0) << "\n";
+        }
+        out << "# HELP slimechunk_stage_calls_total Timed sections per stage (rows for fill, heights and extension)\n"
+            << "# TYPE slimechunk_stage_calls_total counter\n";
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            out << "slimechunk_stage_calls_total{stage=\"" << stageName((Stage)i) << "\"} " << totals.calls[i] << "\n";
+        }
+        out << "# TYPE slimechunk_rectangles_merged_total counter\n"
+            << "slimechunk_rectangles_merged_total " << totals.rectangles << "\n"
+            << "# TYPE slimechunk_deferred_merges_total counter\n"
+            << "slimechunk_deferred_merges_total " << totals.deferredMerges << "\n"
+            << "# HELP slimechunk_arena_allocations_total Times a worker's unit arena had to grow\n"
+            << "# TYPE slimechunk_arena_allocations_total counter\n"
+            << "slimechunk_arena_allocations_total " << totals.arenaAllocations << "\n"
+            << "# TYPE slimechunk_chunks_processed_total counter\n"
+            << "slimechunk_chunks_processed_total " << chunksProcessed << "\n"
+            << "# TYPE slimechunk_units_completed gauge\n"
+            << "slimechunk_units_completed " << unitsCompleted << "\n"
+            << "# TYPE slimechunk_worker_threads gauge\n"
+            << "slimechunk_worker_threads " << threads << "\n"
+            << "# TYPE slimechunk_elapsed_seconds gauge\n"
+            << "slimechunk_elapsed_seconds " << totals.seconds << "\n";
+        if (!out.good()) {
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    return !error;
+}
+
+// RECTANGLE STRUCTURE
+bool Rectangle::operator<(const Rectangle& other) const {
+    // Sort by area (largest first)
+    if (area != other.area) return area > other.area;
+    
+    // Sort by distance from spawn (closest first)
+    if (distanceSquared != other.distanceSquared) return distanceSquared < other.distanceSquared;
+    
+    // Consistent ordering by coordinates, then shape. Transposed rectangles at the same
+    // corner (e.g. 2x3 and 3x2) share area and center, so width must break the tie.
+    if (x != other.x) return x < other.x;
+    if (z != other.z) return z < other.z;
+    return width < other.width;
+}
+
+// Build a result rectangle in chunk coordinates
+static inline Rectangle makeRectangle(int64_t x, int64_t z, int64_t width, int64_t height) {
+    Rectangle rect;
+    rect.x = x;
+    rect.z = z;
+    rect.width = width;
+    rect.height = height;
+    rect.area = width * height;
+    
+    // Calculate distance from spawn (0,0) using rectangle center in BLOCK coordinates
+    int64_t centerChunkX = rect.x + rect.width / 2;
+    int64_t centerChunkZ = rect.z + rect.height / 2;
+    int64_t centerBlockX = centerChunkX * 16;
+    int64_t centerBlockZ = centerChunkZ * 16;
+    rect.distanceSquared = centerBlockX * centerBlockX + centerBlockZ * centerBlockZ;
+    return rect;
+}
+
+// SLIME GRID
+SlimeGrid::SlimeGrid(int64_t rows, int64_t cols) {
+    resize(rows, cols);
+}
+
+SlimeGrid::~SlimeGrid() {
+    if (mappedBytes > 0) {
+        largePageFree(bits, mappedBytes);
+    } else {
+        alignedFree64(bits);
+    }
+}
+
+// Round the stride up to a whole cache line (8 words)
+static int64_t gridRowStride(int64_t cols) {
+    return ((cols + 63) / 64 + 7) & ~7LL;
+}
+
+void SlimeGrid::reserve(int64_t maxRows, int64_t maxCols, bool largePages) {
+    int64_t neededWords = maxRows * gridRowStride(maxCols);
+    if (neededWords <= capacityWords) {
+        return;
+    }
+    if (mappedBytes > 0) {
+        largePageFree(bits, mappedBytes);
+    } else {
+        alignedFree64(bits);
+    }
+    bits = nullptr;
+    capacityWords = 0;
+    mappedBytes = 0;
+    
+    size_t bytes = (size_t)neededWords * sizeof(uint64_t);
+    if (largePages) {
+        bits = (uint64_t*)largePageAlloc(bytes, mappedBytes);
+    }
+    if (bits == nullptr) {
+        mappedBytes = 0;
+        bits = (uint64_t*)alignedAlloc64(bytes);
+        if (bits == nullptr) {
+            throw std::bad_alloc();
+        }
+    }
+    capacityWords = (mappedBytes > 0) ? (int64_t)(mappedBytes / sizeof(uint64_t)) : neededWords;
+}
+
+void SlimeGrid::resize(int64_t newRows, int64_t newCols) {
+    // A grid on mapped pages stays on them when it grows
+    reserve(newRows, newCols, mappedBytes > 0);
+    rows = newRows;
+    cols = newCols;
+    wordsPerRow = gridRowStride(newCols);
+    
+    int64_t neededWords = rows * wordsPerRow;
+    if (neededWords > 0) {
+        std::memset(bits, 0, (size_t)neededWords * sizeof(uint64_t));
+    }
+}
+
+// RESULT STORE
+RectangleStore::RectangleStore(int64_t capacity) : maxEntries(capacity) {
+}
+
+bool RectangleStore::insertBatch(std::vector<Rectangle>& batch, bool blocking) {
+    if (batch.empty()) return true;
+    StageTimer timer(Stage::Merge);
+    
+    // Drop what can't be admitted and sort outside the lock to keep the critical section short
+    int64_t threshold = admissionArea();
+    batch.erase(std::remove_if(batch.begin(), batch.end(),
+                               [threshold](const Rectangle& rect) { return rect.area < threshold; }),
+                batch.end());
+    std::sort(batch.begin(), batch.end());
+    
+    int64_t batchShortSide = 0;
+    for (const Rectangle& rect : batch) {
+        batchShortSide = std::max(batchShortSide, std::min(rect.width, rect.height));
+    }
+    
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    if (blocking) {
+        StageTimer waitTimer(Stage::LockWait);
+        lock.lock();
+    } else if (!lock.try_lock()) {
+        countStageEvent(&StageCounters::deferredMerges);
+        return false;
+    }
+    countStageEvent(&StageCounters::rectangles, batch.size());
+    
+    // With a bound, only the first maxEntries of the sorted batch can survive
+    auto batchEnd = batch.end();
+    if (maxEntries > 0 && (int64_t)batch.size() > maxEntries) {
+        batchEnd = batch.begin() + maxEntries;
+    }
+    rectangles.insert(batch.begin(), batchEnd);
+    
+    if (maxEntries > 0 && (int64_t)rectangles.size() >= maxEntries) {
+        while ((int64_t)rectangles.size() > maxEntries) {
+            rectangles.erase(std::prev(rectangles.end()));
+        }
+        admissionThreshold.store(std::prev(rectangles.end())->area, std::memory_order_relaxed);
+    }
+    count.store((int64_t)rectangles.size(), std::memory_order_relaxed);
+    if (batchShortSide > bestMinSide.load(std::memory_order_relaxed)) {
+        bestMinSide.store(batchShortSide, std::memory_order_relaxed);
+    }
+    lock.unlock();
+    
+    if (handoff != nullptr) {
+        handoff->push(std::vector<Rectangle>(batch.begin(), batchEnd));
+    }
+    batch.clear();
+    return true;
+}
+
+std::vector<Rectangle> RectangleStore::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::vector<Rectangle>(rectangles.begin(), rectangles.end());
+}
+
+// RESULT LOG
+ResultHandoff::~ResultHandoff() {
+    Batch* batch = head.exchange(nullptr);
+    while (batch != nullptr) {
+        Batch* next = batch->next;
+        delete batch;
+        batch = next;
+    }
+}
+
+void ResultHandoff::push(std::vector<Rectangle> rectangles) {
+    if (rectangles.empty()) return;
+    Batch* batch = new Batch{std::move(rectangles), head.load(std::memory_order_relaxed)};
+    while (!head.compare_exchange_weak(batch->next, batch, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+std::vector<Rectangle> ResultHandoff::drain() {
+    // Taking the whole stack leaves nothing for a concurrent pop to race with
+    Batch* batch = head.exchange(nullptr, std::memory_order_acquire);
+    std::vector<Batch*> batches;
+    for (; batch != nullptr; batch = batch->next) {
+        batches.push_back(batch);
+    }
+    std::vector<Rectangle> rectangles;
+    for (auto it = batches.rbegin(); it != batches.rend(); ++it) {
+        rectangles.insert(rectangles.end(), (*it)->rectangles.begin(), (*it)->rectangles.end());
+        delete *it;
+    }
+    return rectangles;
+}
+
+bool ResultLog::open(const std::string& path, bool keepExisting) {
+    out.open(path, std::ios::out | (keepExisting ? std::ios::app : std::ios::trunc));
+    if (!out.is_open()) {
+        std::cerr << "Cannot open result log " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+int64_t ResultLog::appendFrom(ResultHandoff& handoff) {
+    std::vector<Rectangle> rectangles = handoff.drain();
+    for (const Rectangle& rect : rectangles) {
+        out << rect.x << ' ' << rect.z << ' ' << rect.width << ' ' << rect.height << '\n';
+    }
+    out.flush();
+    return (int64_t)rectangles.size();
+}
+
+bool compactResultLog(const std::string& path, int64_t capacity, std::vector<Rectangle>& rectangles) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "Cannot open result log " << path << "\n";
+        return false;
+    }
+    
+    // A last line without its newline was cut short by a crash mid-append and is dropped
+    rectangles.clear();
+    std::string line;
+    while (std::getline(in, line) && !in.eof()) {
+        std::istringstream fields(line);
+        int64_t x, z, width, height;
+        if (fields >> x >> z >> width >> height) {
+            rectangles.push_back(makeRectangle(x, z, width, height));
+        }
+    }
+    std::sort(rectangles.begin(), rectangles.end());
+    rectangles.erase(std::unique(rectangles.begin(), rectangles.end(),
+                                 [](const Rectangle& a, const Rectangle& b) { return !(a < b) && !(b < a); }),
+                     rectangles.end());
+    if (capacity > 0 && (int64_t)rectangles.size() > capacity) {
+        rectangles.resize((size_t)capacity);
+    }
+    return true;
+}
+
+// WORK PROGRESS
+void WorkProgress::reset(int64_t unitTotal) {
+    units = unitTotal;
+    wordCount = (unitTotal + 63) / 64;
+    words.reset(wordCount > 0 ? new std::atomic<uint64_t>[wordCount] : nullptr);
+    for (int64_t i = 0; i < wordCount; i++) {
+        words[i].store(0, std::memory_order_relaxed);
+    }
+    completed.store(0, std::memory_order_relaxed);
+}
+
+void WorkProgress::markDone(int64_t index) {
+    uint64_t bit = 1ULL << (index & 63);
+    uint64_t previous = words[index >> 6].fetch_or(bit, std::memory_order_release);
+    if (!(previous & bit)) {
+        completed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool WorkProgress::isDone(int64_t index) const {
+    return (words[index >> 6].load(std::memory_order_acquire) >> (index & 63)) & 1;
+}
+
+std::vector<uint64_t> WorkProgress::snapshotWords() const {
+    std::vector<uint64_t> snapshot((size_t)wordCount);
+    for (int64_t i = 0; i < wordCount; i++) {
+        snapshot[i] = words[i].load(std::memory_order_acquire);
+    }
+    return snapshot;
+}
+
+bool WorkProgress::loadWords(const std::vector<uint64_t>& source) {
+    if ((int64_t)source.size() != wordCount) {
+        return false;
+    }
+    int64_t total = 0;
+    for (int64_t i = 0; i < wordCount; i++) {
+        uint64_t word = source[i];
+        // Ignore stray bits past the last unit
+        if (i == wordCount - 1 && (units & 63)) {
+            word &= (1ULL << (units & 63)) - 1;
+        }
+        words[i].store(word, std::memory_order_relaxed);
+        total += (int64_t)std::bitset<64>(word).count();
+    }
+    completed.store(total, std::memory_order_relaxed);
+    return true;
+}
+
+// CHECKPOINTING
+// Layout: magic, version, the seed count and seeds, then little-endian int64 fields in
+// Checkpoint order, the completion words, one rectangle section per seed (x, z, width,
+// height, area, distanceSquared) and an FNV-1a hash of everything before it.
+static const char CHECKPOINT_MAGIC[8] = {'S', 'L', 'I', 'M', 'E', 'C', 'K', 'P'};
+static const int64_t CHECKPOINT_VERSION = 4;   // 2: unit grid indices, 3: tiling, 4: seed batches
+
+bool Checkpoint::sameSearch(const Checkpoint& other) const {
+    return worldSeeds == other.worldSeeds &&
+           searchMinX == other.searchMinX && searchMaxX == other.searchMaxX &&
+           searchMinZ == other.searchMinZ && searchMaxZ == other.searchMaxZ &&
+           minimumRectDimension == other.minimumRectDimension &&
+           workUnitSize == other.workUnitSize &&
+           rectMode == other.rectMode &&
+           tiling == other.tiling &&
+           unitCount == other.unitCount;
+}
+
+static void appendInt64(std::vector<uint64_t>& buffer, int64_t value) {
+    buffer.push_back((uint64_t)value);
+}
+
+static void appendRectangle(std::vector<uint64_t>& buffer, const Rectangle& rect) {
+    appendInt64(buffer, rect.x);
+    appendInt64(buffer, rect.z);
+    appendInt64(buffer, rect.width);
+    appendInt64(buffer, rect.height);
+    appendInt64(buffer, rect.area);
+    appendInt64(buffer, rect.distanceSquared);
+}
+
+static uint64_t checkpointHash(const uint64_t* data, size_t count) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < count * sizeof(uint64_t); i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static void beginCheckpointBuffer(std::vector<uint64_t>& buffer, const char magicBytes[8], int64_t version) {
+    uint64_t magic;
+    std::memcpy(&magic, magicBytes, sizeof(magic));
+    buffer.push_back(magic);
+    appendInt64(buffer, version);
+}
+
+// Append the hash and write the buffer to path + ".tmp", then rename it over path
+static bool writeCheckpointFile(const std::string& path, std::vector<uint64_t>& buffer) {
+    buffer.push_back(checkpointHash(buffer.data(), buffer.size()));
+    
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Cannot open checkpoint file " << tempPath << "\n";
+            return false;
+        }
+        out.write((const char*)buffer.data(), (std::streamsize)(buffer.size() * sizeof(uint64_t)));
+        out.flush();
+        if (!out) {
+            std::cerr << "Failed writing checkpoint file " << tempPath << "\n";
+            return false;
+        }
+    }
+    
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::cerr << "Cannot replace checkpoint " << path << ": " << error.message() << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Read a whole checkpoint and check its magic, version and hash. The fields start at
+// buffer[2] and end before buffer.back().
+static bool readCheckpointFile(const std::string& path, const char magicBytes[8], int64_t version,
+                               size_t minimumWords, std::vector<uint64_t>& buffer) {
+    std::ifstream in(path, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+        std::cerr << "Cannot open checkpoint file " << path << "\n";
+        return false;
+    }
+    std::streamsize bytes = in.tellg();
+    if (bytes < 0 || bytes % (std::streamsize)sizeof(uint64_t) != 0) {
+        std::cerr << "Checkpoint " << path << " is truncated\n";
+        return false;
+    }
+    buffer.resize((size_t)(bytes / sizeof(uint64_t)));
+    in.seekg(0);
+    in.read((char*)buffer.data(), bytes);
+    
+    uint64_t magic;
+    std::memcpy(&magic, magicBytes, sizeof(magic));
+    if (buffer.size() < minimumWords || buffer[0] != magic || (int64_t)buffer[1] != version) {
+        std::cerr << "Checkpoint " << path << " has an unknown format\n";
+        return false;
+    }
+    if (checkpointHash(buffer.data(), buffer.size() - 1) != buffer.back()) {
+        std::cerr << "Checkpoint " << path << " is corrupt (hash mismatch)\n";
+        return false;
+    }
+    return true;
+}
+
+bool saveCheckpoint(const std::string& path, const Checkpoint& checkpoint) {
+    if (checkpoint.rectangles.size() != checkpoint.worldSeeds.size()) {
+        std::cerr << "Checkpoint for " << checkpoint.worldSeeds.size() << " seeds has "
+                  << checkpoint.rectangles.size() << " result sets\n";
+        return false;
+    }
+    
+    size_t rectCount = 0;
+    for (const std::vector<Rectangle>& seedRectangles : checkpoint.rectangles) {
+        rectCount += seedRectangles.size();
+    }
+    std::vector<uint64_t> buffer;
+    buffer.reserve(16 + 2 * checkpoint.worldSeeds.size() + checkpoint.completedUnits.size() + 6 * rectCount);
+    
+    beginCheckpointBuffer(buffer, CHECKPOINT_MAGIC, CHECKPOINT_VERSION);
+    appendInt64(buffer, (int64_t)checkpoint.worldSeeds.size());
+    for (int64_t seed : checkpoint.worldSeeds) {
+        appendInt64(buffer, seed);
+    }
+    appendInt64(buffer, checkpoint.searchMinX);
+    appendInt64(buffer, checkpoint.searchMaxX);
+    appendInt64(buffer, checkpoint.searchMinZ);
+    appendInt64(buffer, checkpoint.searchMaxZ);
+    appendInt64(buffer, checkpoint.minimumRectDimension);
+    appendInt64(buffer, checkpoint.workUnitSize);
+    appendInt64(buffer, checkpoint.rectMode);
+    appendInt64(buffer, checkpoint.tiling);
+    appendInt64(buffer, checkpoint.unitCount);
+    appendInt64(buffer, checkpoint.chunksProcessed);
+    appendInt64(buffer, checkpoint.maxDistanceReached);
+    
+    appendInt64(buffer, (int64_t)checkpoint.completedUnits.size());
+    buffer.insert(buffer.end(), checkpoint.completedUnits.begin(), checkpoint.completedUnits.end());
+    
+    for (const std::vector<Rectangle>& seedRectangles : checkpoint.rectangles) {
+        appendInt64(buffer, (int64_t)seedRectangles.size());
+        for (const Rectangle& rect : seedRectangles) {
+            appendRectangle(buffer, rect);
+        }
+    }
+    return writeCheckpointFile(path, buffer);
+}
+
+bool loadCheckpoint(const std::string& path, Checkpoint& checkpoint) {
+    std::vector<uint64_t> buffer;
+    if (!readCheckpointFile(path, CHECKPOINT_MAGIC, CHECKPOINT_VERSION, 16, buffer)) {
+        return false;
+    }
+    
+    // The hash covers every field, so only the section lengths need range checks
+    size_t pos = 2;
+    size_t end = buffer.size() - 1;
+    auto next = [&]() { return pos < end ? (int64_t)buffer[pos++] : 0; };
+    
+    int64_t seedCount = next();
+    if (seedCount < 1 || seedCount > (int64_t)(end - pos)) {
+        std::cerr << "Checkpoint " << path << " is truncated\n";
+        return false;
+    }
+    checkpoint.worldSeeds.resize((size_t)seedCount);
+    for (int64_t& seed : checkpoint.worldSeeds) {
+        seed = next();
+    }
+    checkpoint.searchMinX = next();
+    checkpoint.searchMaxX = next();
+    checkpoint.searchMinZ = next();
+    checkpoint.searchMaxZ = next();
+    checkpoint.minimumRectDimension = next();
+    checkpoint.workUnitSize = next();
+    checkpoint.rectMode = next();
+    checkpoint.tiling = next();
+    checkpoint.unitCount = next();
+    checkpoint.chunksProcessed = next();
+    checkpoint.maxDistanceReached = next();
+    
+    int64_t wordCount = next();
+    if (wordCount < 0 || wordCount > (int64_t)(end - pos)) {
+        std::cerr << "Checkpoint " << path << " is truncated\n";
+        return false;
+    }
+    checkpoint.completedUnits.assign(buffer.begin() + pos, buffer.begin() + pos + wordCount);
+    pos += wordCount;
+    
+    checkpoint.rectangles.assign((size_t)seedCount, std::vector<Rectangle>());
+    for (std::vector<Rectangle>& seedRectangles : checkpoint.rectangles) {
+        int64_t rectCount = next();
+        if (rectCount < 0 || rectCount > (int64_t)(end - pos) / 6) {
+            std::cerr << "Checkpoint " << path << " is truncated\n";
+            return false;
+        }
+        seedRectangles.resize((size_t)rectCount);
+        for (Rectangle& rect : seedRectangles) {
+            rect.x = next();
+            rect.z = next();
+            rect.width = next();
+            rect.height = next();
+            rect.area = next();
+            rect.distanceSquared = next();
+        }
+    }
+    return true;
+}
+
+// Seed sweeps use their own magic: completedBlocks, the seed range and the region, then
+// the results as (seed, x, z, width, height, area, distanceSquared)
+static const char SEED_SWEEP_MAGIC[8] = {'S', 'L', 'I', 'M', 'E', 'S', 'W', 'P'};
+static const int64_t SEED_SWEEP_VERSION = 1;
+
+bool SeedSweepCheckpoint::sameSweep(const SeedSweepCheckpoint& other) const {
+    return seedStart == other.seedStart && seedEnd == other.seedEnd &&
+           searchMinX == other.searchMinX && searchMaxX == other.searchMaxX &&
+           searchMinZ == other.searchMinZ && searchMaxZ == other.searchMaxZ &&
+           minimumRectDimension == other.minimumRectDimension;
+}
+
+bool saveSeedSweepCheckpoint(const std::string& path, const SeedSweepCheckpoint& checkpoint) {
+    std::vector<uint64_t> buffer;
+    buffer.reserve(16 + 7 * checkpoint.results.size());
+    beginCheckpointBuffer(buffer, SEED_SWEEP_MAGIC, SEED_SWEEP_VERSION);
+    appendInt64(buffer, checkpoint.seedStart);
+    appendInt64(buffer, checkpoint.seedEnd);
+    appendInt64(buffer, checkpoint.searchMinX);
+    appendInt64(buffer, checkpoint.searchMaxX);
+    appendInt64(buffer, checkpoint.searchMinZ);
+    appendInt64(buffer, checkpoint.searchMaxZ);
+    appendInt64(buffer, checkpoint.minimumRectDimension);
+    appendInt64(buffer, checkpoint.completedBlocks);
+    appendInt64(buffer, checkpoint.seedsProcessed);
+    
+    appendInt64(buffer, (int64_t)checkpoint.results.size());
+    for (const SeedRectangle& entry : checkpoint.results) {
+        appendInt64(buffer, entry.worldSeed);
+        appendRectangle(buffer, entry.rect);
+    }
+    return writeCheckpointFile(path, buffer);
+}
+
+bool loadSeedSweepCheckpoint(const std::string& path, SeedSweepCheckpoint& checkpoint) {
+    std::vector<uint64_t> buffer;
+    if (!readCheckpointFile(path, SEED_SWEEP_MAGIC, SEED_SWEEP_VERSION, 13, buffer)) {
+        return false;
+    }
+    
+    size_t pos = 2;
+    size_t end = buffer.size() - 1;
+    auto next = [&]() { return pos < end ? (int64_t)buffer[pos++] : 0; };
+    
+    checkpoint.seedStart = next();
+    checkpoint.seedEnd = next();
+    checkpoint.searchMinX = next();
+    checkpoint.searchMaxX = next();
+    checkpoint.searchMinZ = next();
+    checkpoint.searchMaxZ = next();
+    checkpoint.minimumRectDimension = next();
+    checkpoint.completedBlocks = next();
+    checkpoint.seedsProcessed = next();
+    
+    int64_t resultCount = next();
+    if (resultCount < 0 || resultCount > (int64_t)(end - pos) / 7) {
+        std::cerr << "Checkpoint " << path << " is truncated\n";
+        return false;
+    }
+    checkpoint.results.resize((size_t)resultCount);
+    for (SeedRectangle& entry : checkpoint.results) {
+        entry.worldSeed = next();
+        entry.rect.x = next();
+        entry.rect.z = next();
+        entry.rect.width = next();
+        entry.rect.height = next();
+        entry.rect.area = next();
+        entry.rect.distanceSquared = next();
+    }
+    return true;
+}
+
+// RECTANGLE FINDING
+
+// Serializes debug output between threads
+static std::mutex debugOutputMutex;
+
+// AND each word of a multi-word row with the row shifted right by shift bits
+// (towards lower columns), so bit c ends up set only if bits c and c+shift were set.
+static inline void andShiftedRight(uint64_t* words, int64_t count, int64_t shift) {
+    int64_t wordShift = shift >> 6;
+    int64_t bitShift = shift & 63;
+    
+    for (int64_t k = 0; k < count; k++) {
+        uint64_t lo = (k + wordShift < count) ? words[k + wordShift] : 0;
+        uint64_t hi = (k + wordShift + 1 < count) ? words[k + wordShift + 1] : 0;
+        uint64_t shifted = bitShift ? ((lo >> bitShift) | (hi << (64 - bitShift))) : lo;
+        words[k] &= shifted;
+    }
+}
+
+// Fast filter for the minimum-dimension query: find the rows covered by at least one
+// all-slime N x N square. N consecutive rows are ANDed together and runs of N set bits
+// are found with shift-AND chains, 64 columns per operation. Both chains double their
+// reach each step, so a window costs O(log N) passes instead of N - 1.
+//
+// Every rectangle of at least N x N is covered row by row by the squares inside it, so
+// it lies entirely within one contiguous band of covered rows. Running the histogram
+// stage over just those bands reports exactly the same rectangles as a full scan.
+// Returns false (and no bands) when the grid has no qualifying square at all.
+bool findSquareCandidateBands(const SlimeGrid& grid, int64_t minimumRectDimension,
+                              std::vector<std::pair<int64_t, int64_t>>& bands,
+                              std::vector<uint64_t>* window) {
+    bands.clear();
+    
+    int64_t n = std::max<int64_t>(minimumRectDimension, 1);
+    int64_t rows = grid.rows;
+    int64_t words = grid.usedWords();
+    
+    if (rows < n || grid.cols < n) return false;
+    
+    // window[r] ends up holding the AND of rows [r - n + 1, r]
+    std::vector<uint64_t> localWindow;
+    std::vector<uint64_t>& windowWords = (window != nullptr) ? *window : localWindow;
+    windowWords.resize(rows * words);
+    uint64_t* windowBits = windowWords.data();
+    for (int64_t r = 0; r < rows; r++) {
+        std::memcpy(&windowBits[r * words], grid.row(r), words * sizeof(uint64_t));
+    }
+    
+    int64_t covered = 0;
+    while (covered < n - 1) {
+        int64_t step = std::min(covered + 1, n - 1 - covered);
+        // Bottom-up so window[r - step] still holds the previous pass
+        for (int64_t r = rows - 1; r >= step; r--) {
+            uint64_t* dst = &windowBits[r * words];
+            const uint64_t* src = &windowBits[(r - step) * words];
+            for (int64_t k = 0; k < words; k++) {
+                dst[k] &= src[k];
+            }
+        }
+        std::memset(windowBits, 0, std::min(step, rows) * words * sizeof(uint64_t));
+        covered += step;
+    }
+    
+    for (int64_t r = n - 1; r < rows; r++) {
+        uint64_t* rowWords = &windowBits[r * words];
+        
+        uint64_t any = 0;
+        for (int64_t k = 0; k < words; k++) {
+            any |= rowWords[k];
+        }
+        if (any == 0) continue;
+        
+        // Horizontal runs of at least n set bits
+        int64_t reach = 0;
+        while (reach < n - 1 && any != 0) {
+            int64_t step = std::min(reach + 1, n - 1 - reach);
+            andShiftedRight(rowWords, words, step);
+            reach += step;
+            
+            any = 0;
+            for (int64_t k = 0; k < words; k++) {
+                any |= rowWords[k];
+            }
+        }
+        if (any == 0) continue;
+        
+        // Rows [r - n + 1, r] are covered; merge with the previous band when touching
+        int64_t bandStart = r - n + 1;
+        if (!bands.empty() && bandStart <= bands.back().second) {
+            bands.back().second = r + 1;
+        } else {
+            bands.push_back({bandStart, r + 1});
+        }
+    }
+    
+    return !bands.empty();
+}
+
+// True if every bit in columns [first, last] of a row is set
+static inline bool rowRangeAllSet(const uint64_t* rowBits, int64_t first, int64_t last) {
+    int64_t firstWord = first >> 6;
+    int64_t lastWord = last >> 6;
+    uint64_t firstMask = ~0ULL << (first & 63);
+    uint64_t lastMask = ~0ULL >> (63 - (last & 63));
+    
+    if (firstWord == lastWord) {
+        uint64_t mask = firstMask & lastMask;
+        return (rowBits[firstWord] & mask) == mask;
+    }
+    if ((rowBits[firstWord] & firstMask) != firstMask) return false;
+    for (int64_t w = firstWord + 1; w < lastWord; w++) {
+        if (rowBits[w] != ~0ULL) return false;
+    }
+    return (rowBits[lastWord] & lastMask) == lastMask;
+}
+
+RectangleScanner::RectangleScanner(int64_t cols, int64_t offsetX, int64_t offsetZ,
+                                   int64_t minimumRectDimension, RectMode rectMode,
+                                   int64_t minimumArea, bool debugMode, SimdLevel simdLevel) {
+    reset(cols, offsetX, offsetZ, minimumRectDimension, rectMode, minimumArea, debugMode, simdLevel);
+}
+
+void RectangleScanner::reset(int64_t cols, int64_t offsetX, int64_t offsetZ,
+                             int64_t minimumRectDimension, RectMode rectMode,
+                             int64_t minimumArea, bool debugMode, SimdLevel simdLevel) {
+    this->cols = cols;
+    this->words = (cols + 63) / 64;
+    this->offsetX = offsetX;
+    this->offsetZ = offsetZ;
+    this->minimumRectDimension = minimumRectDimension;
+    this->minimumArea = minimumArea;
+    this->rectMode = rectMode;
+    this->debugMode = debugMode;
+    kernel = &slimeKernelFor(simdLevel);
+    heights.assign((size_t)((cols + 31) / 32 * 32), 0);
+    // Rows with every height below this can't end a qualifying rectangle
+    tallThreshold = (uint16_t)std::min<int64_t>(std::max<int64_t>(minimumRectDimension, 1), 65535);
+    if (cols > 0) {
+        stack.reserve((size_t)cols + 1);
+    }
+    pendingRow = nullptr;
+    pendingIndex = 0;
+    pendingTall = false;
+}
+
+void RectangleScanner::begin(int64_t firstRow) {
+    std::fill(heights.begin(), heights.end(), (uint16_t)0);
+    pendingRow = nullptr;
+    pendingIndex = firstRow - 1;
+    
+    if (debugMode) {
+        bool isTestRegion = (offsetX <= 1495 && offsetX + cols > 1495 && offsetZ + firstRow <= 8282);
+        if (isTestRegion) {
+            std::lock_guard<std::mutex> lock(debugOutputMutex);
+            std::cout << "[DEBUG] Rectangle scan started: offsetX=" << offsetX
+                      << " offsetZ=" << offsetZ << " firstRow=" << firstRow << " cols=" << cols << "\n";
+        }
+    }
+}
+
+void RectangleScanner::pushRow(const uint64_t* rowBits, std::vector<Rectangle>& results) {
+    if (pendingRow != nullptr && pendingTall) {
+        StageTimer timer(Stage::Extension);
+        scanPendingRow(rowBits, results);
+    }
+    StageTimer timer(Stage::Heights);
+    pendingTall = kernel->updateHeights(heights.data(), rowBits, cols, tallThreshold);
+    pendingRow = rowBits;
+    pendingIndex++;
+}
+
+void RectangleScanner::finish(std::vector<Rectangle>& results) {
+    if (pendingRow != nullptr && pendingTall) {
+        StageTimer timer(Stage::Extension);
+        scanPendingRow(nullptr, results);
+    }
+    pendingRow = nullptr;
+}
+
+// Sizes are rounded the way the scanner and grid round them, so a unit up to the size
+// given here never grows the arena
+UnitArena::UnitArena(int64_t maxRows, int64_t maxCols, SimdLevel simdLevel) {
+    slimeGrid.reserve(maxRows, maxCols, true);
+    rectangleScanner.reset(maxCols, 0, 0, 1, RectMode::Maximal, 0, false, simdLevel);
+    candidateBands.reserve((size_t)maxRows);
+    window.reserve((size_t)(maxRows * gridRowStride(maxCols)));
+    foundRectangles.reserve(256);
+    foundCapacity = foundRectangles.capacity();
+}
+
+void UnitArena::countAllocation() {
+    allocationCount++;
+    countStageEvent(&StageCounters::arenaAllocations);
+}
+
+SlimeGrid& UnitArena::grid(int64_t rows, int64_t cols) {
+    int64_t capacity = slimeGrid.capacityWords;
+    slimeGrid.resize(rows, cols);
+    if (slimeGrid.capacityWords != capacity) {
+        countAllocation();
+    }
+    // A band is at least one row long, so this covers the filter's output for the grid
+    if (candidateBands.capacity() < (size_t)rows) {
+        candidateBands.reserve((size_t)rows);
+        countAllocation();
+    }
+    if (window.capacity() < (size_t)(rows * slimeGrid.usedWords())) {
+        window.reserve((size_t)(rows * slimeGrid.wordsPerRow));
+        countAllocation();
+    }
+    return slimeGrid;
+}
+
+RectangleScanner& UnitArena::scanner(int64_t cols, int64_t offsetX, int64_t offsetZ,
+                                     int64_t minimumRectDimension, RectMode rectMode,
+                                     int64_t minimumArea, bool debugMode, SimdLevel simdLevel) {
+    size_t capacity = rectangleScanner.capacityBytes();
+    rectangleScanner.reset(cols, offsetX, offsetZ, minimumRectDimension, rectMode, minimumArea,
+                           debugMode, simdLevel);
+    if (rectangleScanner.capacityBytes() != capacity) {
+        countAllocation();
+    }
+    return rectangleScanner;
+}
+
+std::vector<Rectangle>& UnitArena::found() {
+    // The vector grows while a grid is scanned; that is counted here, on the next request
+    if (foundRectangles.capacity() != foundCapacity) {
+        foundCapacity = foundRectangles.capacity();
+        countAllocation();
+    }
+    foundRectangles.clear();
+    return foundRectangles;
+}
+
+std::vector<std::pair<int64_t, int64_t>>& UnitArena::bands() {
+    candidateBands.clear();
+    return candidateBands;
+}
+
+size_t UnitArena::bytes() const {
+    return (size_t)(slimeGrid.capacityWords + window.capacity()) * sizeof(uint64_t) +
+           rectangleScanner.capacityBytes() + candidateBands.capacity() * sizeof(candidateBands[0]) +
+           foundRectangles.capacity() * sizeof(Rectangle);
+}
+
+void RectangleScanner::report(int64_t left, int64_t width, int64_t height, std::vector<Rectangle>& results) {
+    Rectangle rect = makeRectangle(offsetX + left, offsetZ + (pendingIndex - height + 1), width, height);
+    
+    if (debugMode && rect.x == 1495 && rect.z == 8282 && rect.width == 3 && rect.height == 3) {
+        std::lock_guard<std::mutex> lock(debugOutputMutex);
+        std::cout << "[DEBUG] Found target 3x3! offsetX=" << offsetX << " offsetZ=" << offsetZ
+                  << " i=" << left << " row=" << pendingIndex << " h=" << height << "\n";
+    }
+    
+    results.push_back(rect);
+}
+
+// Exhaustive mode reports, for every start column and end column on a row, the tallest
+// rectangle meeting the minimum size. Maximal mode reports a rectangle only if it cannot
+// be extended in any direction within the scanned rows. Rectangles smaller than
+// minimumArea are never constructed.
+void RectangleScanner::scanPendingRow(const uint64_t* nextRowBits, std::vector<Rectangle>& results) {
+    const uint16_t* height = heights.data();
+    
+    if (rectMode == RectMode::Maximal) {
+        // Monotonic stack of (height, left column). Each bar popped at column j spans
+        // [left, j - 1] and is maximal to the left, right and top by construction; it is
+        // reported if the next row cannot extend it downwards.
+        stack.clear();
+        
+        for (int64_t j = 0; j <= cols; j++) {
+            int64_t h = (j < cols) ? height[j] : 0;
+            int64_t left = j;
+            
+            while (!stack.empty() && stack.back().first > h) {
+                int64_t barHeight = stack.back().first;
+                int64_t barLeft = stack.back().second;
+                int64_t width = j - barLeft;
+                stack.pop_back();
+                left = barLeft;
+                
+                if (width >= minimumRectDimension && barHeight >= minimumRectDimension &&
+                    width * barHeight >= minimumArea &&
+                    (nextRowBits == nullptr || !rowRangeAllSet(nextRowBits, barLeft, j - 1))) {
+                    report(barLeft, width, barHeight, results);
+                }
+            }
+            
+            if (h > 0 && (stack.empty() || stack.back().first < h)) {
+                stack.push_back({h, left});
+            }
+        }
+        return;
+    }
+    
+    // For each set position, find all maximal rectangles ending at this row. The minimum
+    // height only falls while extending right, so the extension stops at the first column
+    // shorter than the minimum dimension and the row costs O(reported + cols * N).
+    int64_t minimumHeight = std::max<int64_t>(minimumRectDimension, 1);
+    for (int64_t w = 0; w < words; w++) {
+        uint64_t bitsLeft = pendingRow[w];
+        while (bitsLeft) {
+            int64_t i = w * 64 + countTrailingZeros64(bitsLeft);
+            bitsLeft &= bitsLeft - 1;
+            
+            int64_t minHeight = height[i];
+            if (minHeight < minimumHeight) continue;
+            
+            // Extend rectangle to the right
+            for (int64_t j = i; j < cols; j++) {
+                minHeight = std::min<int64_t>(minHeight, height[j]);
+                if (minHeight < minimumHeight) break;
+                int64_t width = j - i + 1;
+                
+                // Report all rectangles that meet minimum size requirement
+                if (width >= minimumRectDimension && width * minHeight >= minimumArea) {
+                    report(i, width, minHeight, results);
+                }
+            }
+        }
+    }
+}
+
+void findMaximalRectangles(const SlimeGrid& grid, 
+                           int64_t startRow, int64_t endRow,
+                           int64_t offsetX, int64_t offsetZ,
+                           int64_t minimumRectDimension,
+                           std::vector<Rectangle>& results,
+                           RectMode rectMode,
+                           int64_t minimumArea,
+                           bool debugMode,
+                           SimdLevel simdLevel) {
+    if (grid.rows == 0 || endRow <= startRow) return;
+    
+    RectangleScanner scanner(grid.cols, offsetX, offsetZ, minimumRectDimension, rectMode, minimumArea,
+                             debugMode, simdLevel);
+    scanner.begin(startRow);
+    for (int64_t row = startRow; row < endRow; row++) {
+        scanner.pushRow(grid.row(row), results);
+    }
+    scanner.finish(results);
+}
+
+// Fill a grid with the slime chunks of [minX, minX + cols) x [minZ, minZ + rows). With a
+// scanner, each row is pushed to it right after the kernel writes it, while still in L1.
+static void fillSlimeGrid(SlimeGrid& grid, int64_t minX, int64_t minZ, int64_t worldSeed,
+                          const EngineConfig& engines,
+                          RectangleScanner* scanner = nullptr, std::vector<Rectangle>* results = nullptr) {
+    const SlimeKernel& kernel = slimeKernelFor(engines.simdLevel);
+    
+    // Row sweep computes the Z terms once per row and the X terms by finite differences;
+    // batch feeds explicit coordinates through the vector check
+    auto fillRow = (engines.gridEngine == GridEngine::RowIncremental) ? kernel.fillRowIncremental
+                                                                      : kernel.fillRowBatch;
+    for (int64_t z = 0; z < grid.rows; z++) {
+        {
+            StageTimer timer(Stage::Fill);
+            if (engines.bitmapCache != nullptr) {
+                engines.bitmapCache->readRow(minX, minZ + z, grid.cols, grid.row(z), engines);
+            } else {
+                fillRow(minX, minZ + z, grid.cols, worldSeed, grid.row(z));
+            }
+        }
+        if (scanner != nullptr) {
+            scanner->pushRow(grid.row(z), *results);
+        }
+    }
+}
+
+// No side of a rectangle in the grid can exceed its larger dimension, so the store's
+// admission area implies a minimum for the shorter side
+static int64_t gridScanDimension(const SlimeGrid& grid, int64_t minimumRectDimension, int64_t minimumArea) {
+    int64_t longestSide = std::max(grid.rows, grid.cols);
+    return std::max(minimumRectDimension, (minimumArea + longestSide - 1) / longestSide);
+}
+
+// Run the square filter over a filled grid and hand its candidate bands to the scanner.
+// Most units have no N x N square at all and skip the histogram stage entirely.
+static void scanSquareBands(const SlimeGrid& grid, int64_t scanDimension, RectangleScanner& scanner,
+                            std::vector<Rectangle>& results, std::vector<std::pair<int64_t, int64_t>>& bands,
+                            std::vector<uint64_t>* window = nullptr) {
+    {
+        StageTimer timer(Stage::Filter);
+        findSquareCandidateBands(grid, scanDimension, bands, window);
+    }
+    for (const auto& band : bands) {
+        scanner.begin(band.first);
+        for (int64_t row = band.first; row < band.second; row++) {
+            scanner.pushRow(grid.row(row), results);
+        }
+        scanner.finish(results);
+    }
+}
+
+// Fill a grid whose first cell is chunk (offsetX, offsetZ) and run the configured filter
+// and rectangle stage over it
+static void fillAndScanGrid(SlimeGrid& grid, int64_t offsetX, int64_t offsetZ, int64_t worldSeed,
+                            int64_t minimumRectDimension, int64_t minimumArea,
+                            const EngineConfig& engines, std::vector<Rectangle>& results,
+                            bool debugMode, UnitArena& scratch) {
+    int64_t scanDimension = gridScanDimension(grid, minimumRectDimension, minimumArea);
+    RectangleScanner& scanner = scratch.scanner(grid.cols, offsetX, offsetZ, scanDimension, engines.rectMode,
+                                                minimumArea, debugMode, engines.simdLevel);
+    
+    if (engines.rectFilter == RectFilter::SquareAnd) {
+        // The filter needs the whole grid
+        fillSlimeGrid(grid, offsetX, offsetZ, worldSeed, engines);
+        scanSquareBands(grid, scanDimension, scanner, results, scratch.bands(), &scratch.filterWindow());
+    } else {
+        scanner.begin(0);
+        fillSlimeGrid(grid, offsetX, offsetZ, worldSeed, engines, &scanner, &results);
+        scanner.finish(results);
+    }
+}
+
+// Maximal mode over a padded grid. A rectangle that is maximal in the grid is maximal in
+// the search region unless it touches a grid edge inside the search bounds. The grid starts
+// one chunk before the unit, so a rectangle with its top-left corner in the unit can only
+// touch the far (right or bottom) edges, and the unit keeps exactly those rectangles:
+// every maximal rectangle is reported by the one unit holding its corner.
+//
+// A maximal rectangle of the region that has its corner in the unit but leaves the grid
+// covers at least margin + 1 >= N chunks of it on the sides it leaves by, so it shows up as
+// a grid rectangle overlapping the unit and touching a far edge. Then the margin is too
+// small and false is returned, leaving results alone; the caller scans again with a wider
+// one. Rectangles are scanned without an area bound (the admission area assumes they fit
+// in the grid) and only checked against minimumArea here.
+static bool settlePaddedMaximal(const std::vector<Rectangle>& found, const WorkUnit& unit, const WorkUnit& grid,
+                                int64_t searchMaxChunkX, int64_t searchMaxChunkZ, int64_t minimumArea,
+                                std::vector<Rectangle>& results) {
+    for (const Rectangle& rect : found) {
+        bool farEdge = (rect.x + rect.width == grid.maxX && grid.maxX < searchMaxChunkX) ||
+                       (rect.z + rect.height == grid.maxZ && grid.maxZ < searchMaxChunkZ);
+        bool overlapsUnit = rect.x < unit.maxX && rect.x + rect.width > unit.minX &&
+                            rect.z < unit.maxZ && rect.z + rect.height > unit.minZ;
+        if (farEdge && overlapsUnit) {
+            return false;
+        }
+    }
+    for (const Rectangle& rect : found) {
+        if (rect.x >= unit.minX && rect.x < unit.maxX && rect.z >= unit.minZ && rect.z < unit.maxZ &&
+            rect.area >= minimumArea) {
+            results.push_back(rect);
+        }
+    }
+    return true;
+}
+
+// Padded grid of a unit for maximal mode: one chunk before it, margin after it
+static WorkUnit paddedMaximalBounds(const WorkUnit& unit, int64_t margin, int64_t searchMinX, int64_t searchMaxX,
+                                    int64_t searchMinZ, int64_t searchMaxZ) {
+    WorkUnit grid = unit;
+    grid.minX = std::max(unit.minX - 1, searchMinX / 16);
+    grid.maxX = std::min(unit.maxX + margin, searchMaxX / 16);
+    grid.minZ = std::max(unit.minZ - 1, searchMinZ / 16);
+    grid.maxZ = std::min(unit.maxZ + margin, searchMaxZ / 16);
+    return grid;
+}
+
+// First margin after a unit in maximal mode. Wider than N - 1 for small N, where a
+// rectangle reaching N - 1 past the unit is common enough to rescan most units.
+static int64_t firstPaddedMargin(int64_t minimumRectDimension) {
+    return std::max<int64_t>(minimumRectDimension - 1, 4);
+}
+
+// Scan a unit in maximal mode, widening the margin until settlePaddedMaximal accepts it
+static void scanPaddedMaximal(const WorkUnit& unit, int64_t margin, int64_t worldSeed,
+                              int64_t minimumRectDimension, int64_t minimumArea,
+                              int64_t searchMinX, int64_t searchMaxX, int64_t searchMinZ, int64_t searchMaxZ,
+                              const EngineConfig& engines, std::vector<Rectangle>& results,
+                              bool debugMode, UnitArena& scratch) {
+    while (true) {
+        WorkUnit bounds = paddedMaximalBounds(unit, margin, searchMinX, searchMaxX, searchMinZ, searchMaxZ);
+        int64_t width = bounds.maxX - bounds.minX;
+        int64_t height = bounds.maxZ - bounds.minZ;
+        if (width < minimumRectDimension || height < minimumRectDimension) {
+            return;
+        }
+        std::vector<Rectangle>& found = scratch.found();
+        SlimeGrid& grid = scratch.grid(height, width);
+        fillAndScanGrid(grid, bounds.minX, bounds.minZ, worldSeed, minimumRectDimension, 0, engines, found,
+                        debugMode, scratch);
+        if (settlePaddedMaximal(found, unit, bounds, searchMaxX / 16, searchMaxZ / 16, minimumArea, results)) {
+            return;
+        }
+        margin = std::max<int64_t>(margin * 2, 1);
+    }
+}
+
+int64_t paddedUnitSide(int64_t unitSize, int64_t minimumRectDimension) {
+    return unitSize + std::max(2 * (minimumRectDimension - 1), 1 + firstPaddedMargin(minimumRectDimension));
+}
+
+// Process a rectangular region with overlap padding to catch boundary rectangles.
+// Exhaustive mode pads N - 1 on every side and reports everything the padded grid holds;
+// the store drops the duplicates.
+void processRegion(int64_t minX, int64_t maxX, int64_t minZ, int64_t maxZ,
+                   int64_t worldSeed,
+                   int64_t minimumRectDimension,
+                   int64_t minimumArea,
+                   int64_t searchMinX, int64_t searchMaxX, int64_t searchMinZ, int64_t searchMaxZ,
+                   std::vector<Rectangle>& localResults,
+                   std::atomic<int64_t>& chunksProcessed,
+                   const EngineConfig& engines,
+                   bool debugMode,
+                   UnitArena* arena) {
+    
+    if (debugMode) {
+        bool isDebugRegion = (minX <= 1495 && maxX > 1495 && minZ <= 8284 && maxZ > 8284);
+        if (isDebugRegion) {
+            std::lock_guard<std::mutex> lock(debugOutputMutex);
+            std::cout << "[DEBUG] processRegion input: X[" << minX << "-" << maxX << "] Z[" << minZ << "-" << maxZ << "]\n";
+            std::cout << "[DEBUG] SEARCH bounds (chunks): X[" << (searchMinX/16) << "-" << (searchMaxX/16) 
+                      << "] Z[" << (searchMinZ/16) << "-" << (searchMaxZ/16) << "]\n";
+        }
+    }
+    
+    // Build slime chunk grids with the kernels selected at startup, in the worker's arena if
+    // it has one
+    UnitArena localArena;
+    UnitArena& scratch = (arena != nullptr) ? *arena : localArena;
+    
+    if (engines.rectMode == RectMode::Maximal) {
+        WorkUnit unit{minX, maxX, minZ, maxZ, 0};
+        scanPaddedMaximal(unit, firstPaddedMargin(minimumRectDimension), worldSeed, minimumRectDimension,
+                          minimumArea, searchMinX, searchMaxX, searchMinZ, searchMaxZ, engines, localResults,
+                          debugMode, scratch);
+        chunksProcessed += (maxX - minX) * (maxZ - minZ);
+        return;
+    }
+    
+    // Add padding to ensure rectangles on boundaries aren't missed
+    int64_t paddedMinX = minX - minimumRectDimension + 1;
+    int64_t paddedMaxX = maxX + minimumRectDimension - 1;
+    int64_t paddedMinZ = minZ - minimumRectDimension + 1;
+    int64_t paddedMaxZ = maxZ + minimumRectDimension - 1;
+    
+    // Clamp to search bounds (convert block bounds to chunk bounds)
+    int64_t searchMinChunkX = searchMinX / 16;
+    int64_t searchMaxChunkX = searchMaxX / 16;
+    int64_t searchMinChunkZ = searchMinZ / 16;
+    int64_t searchMaxChunkZ = searchMaxZ / 16;
+    
+    paddedMinX = std::max(paddedMinX, searchMinChunkX);
+    paddedMaxX = std::min(paddedMaxX, searchMaxChunkX);
+    paddedMinZ = std::max(paddedMinZ, searchMinChunkZ);
+    paddedMaxZ = std::min(paddedMaxZ, searchMaxChunkZ);
+    
+    int64_t width = paddedMaxX - paddedMinX;
+    int64_t height = paddedMaxZ - paddedMinZ;
+    
+    if (width < minimumRectDimension || height < minimumRectDimension) {
+        return;
+    }
+    
+    SlimeGrid& grid = scratch.grid(height, width);
+    fillAndScanGrid(grid, paddedMinX, paddedMinZ, worldSeed, minimumRectDimension, minimumArea, engines,
+                    localResults, debugMode, scratch);
+    
+    // Only count the non-padded region for progress tracking
+    chunksProcessed += (maxX - minX) * (maxZ - minZ);
+}
+
+void processRegionMultiSeed(int64_t minX, int64_t maxX, int64_t minZ, int64_t maxZ,
+                            const std::vector<int64_t>& worldSeeds,
+                            int64_t minimumRectDimension,
+                            const std::vector<int64_t>& seedDimensions,
+                            const std::vector<int64_t>& seedAreas,
+                            int64_t searchMinX, int64_t searchMaxX, int64_t searchMinZ, int64_t searchMaxZ,
+                            std::vector<std::vector<Rectangle>>& localResults,
+                            std::atomic<int64_t>& chunksProcessed,
+                            const EngineConfig& engines,
+                            bool debugMode,
+                            const std::vector<std::unique_ptr<UnitArena>>* arenas) {
+    // Same padding and clamping as processRegion, so with equal dimensions every seed
+    // finds exactly what a single-seed run would. In maximal mode the first margin fits
+    // the largest seed dimension; a seed that needs a wider one is rescanned on its own.
+    int64_t seedCount = (int64_t)worldSeeds.size();
+    bool maximal = (engines.rectMode == RectMode::Maximal);
+    WorkUnit unit{minX, maxX, minZ, maxZ, 0};
+    int64_t margin = firstPaddedMargin(std::max(minimumRectDimension,
+                                                *std::max_element(seedDimensions.begin(), seedDimensions.end())));
+    WorkUnit bounds = unit;
+    if (maximal) {
+        bounds = paddedMaximalBounds(unit, margin, searchMinX, searchMaxX, searchMinZ, searchMaxZ);
+    } else {
+        bounds.minX = std::max(minX - minimumRectDimension + 1, searchMinX / 16);
+        bounds.maxX = std::min(maxX + minimumRectDimension - 1, searchMaxX / 16);
+        bounds.minZ = std::max(minZ - minimumRectDimension + 1, searchMinZ / 16);
+        bounds.maxZ = std::min(maxZ + minimumRectDimension - 1, searchMaxZ / 16);
+    }
+    int64_t paddedMinX = bounds.minX;
+    int64_t paddedMinZ = bounds.minZ;
+    int64_t width = bounds.maxX - bounds.minX;
+    int64_t height = bounds.maxZ - bounds.minZ;
+    
+    if (width < minimumRectDimension || height < minimumRectDimension) {
+        return;
+    }
+    
+    // Each seed builds its grid and scanner in its own arena, the worker's if it has them.
+    // Maximal mode collects each seed's grid rectangles in the arena before settling them.
+    std::vector<std::unique_ptr<UnitArena>> localArenas;
+    if (arenas == nullptr) {
+        for (int64_t k = 0; k < seedCount; k++) {
+            localArenas.push_back(std::make_unique<UnitArena>());
+        }
+        arenas = &localArenas;
+    }
+    std::vector<SlimeGrid*> grids(seedCount);
+    std::vector<RectangleScanner*> scanners(seedCount);
+    std::vector<std::vector<Rectangle>*> found(seedCount);
+    std::vector<uint64_t*> rowBits(seedCount);
+    for (int64_t k = 0; k < seedCount; k++) {
+        UnitArena& scratch = *(*arenas)[k];
+        int64_t scanArea = maximal ? 0 : seedAreas[k];
+        grids[k] = &scratch.grid(height, width);
+        scanners[k] = &scratch.scanner(width, paddedMinX, paddedMinZ,
+                                       gridScanDimension(*grids[k], seedDimensions[k], scanArea),
+                                       engines.rectMode, scanArea, debugMode, engines.simdLevel);
+        found[k] = maximal ? &scratch.found() : &localResults[k];
+    }
+    
+    // Without the square filter every row goes to its seed's scanner while still in cache
+    bool streamRows = (engines.rectFilter != RectFilter::SquareAnd);
+    if (streamRows) {
+        for (RectangleScanner* scanner : scanners) {
+            scanner->begin(0);
+        }
+    }
+    
+    const SlimeKernel& kernel = slimeKernelFor(engines.simdLevel);
+    for (int64_t z = 0; z < height; z++) {
+        for (int64_t k = 0; k < seedCount; k++) {
+            rowBits[k] = grids[k]->row(z);
+        }
+        {
+            StageTimer timer(Stage::Fill);
+            kernel.fillRowMultiSeed(paddedMinX, paddedMinZ + z, width, worldSeeds.data(), seedCount, rowBits.data());
+        }
+        if (streamRows) {
+            for (int64_t k = 0; k < seedCount; k++) {
+                scanners[k]->pushRow(rowBits[k], *found[k]);
+            }
+        }
+    }
+    
+    for (int64_t k = 0; k < seedCount; k++) {
+        UnitArena& scratch = *(*arenas)[k];
+        if (streamRows) {
+            scanners[k]->finish(*found[k]);
+        } else {
+            scanSquareBands(*grids[k], gridScanDimension(*grids[k], seedDimensions[k], maximal ? 0 : seedAreas[k]),
+                            *scanners[k], *found[k], scratch.bands(), &scratch.filterWindow());
+        }
+    }
+    
+    // A rescan reuses the seed's arena; its first scan is no longer needed by then
+    if (maximal) {
+        for (int64_t k = 0; k < seedCount; k++) {
+            if (!settlePaddedMaximal(*found[k], unit, bounds, searchMaxX / 16, searchMaxZ / 16, seedAreas[k],
+                                     localResults[k])) {
+                scanPaddedMaximal(unit, std::max<int64_t>(margin * 2, 1), worldSeeds[k], seedDimensions[k],
+                                  seedAreas[k], searchMinX, searchMaxX, searchMinZ, searchMaxZ, engines, localResults[k],
+                                  debugMode, *(*arenas)[k]);
+            }
+        }
+    }
+    
+    chunksProcessed += (maxX - minX) * (maxZ - minZ);
+}
+
+// BITMAP CACHE
+// Layout: a 4 KiB header page (magic, version, worldSeed, the chunk bounds of the unit
+// grid, unit size and tile row stride as int64), one valid byte per tile padded to a
+// page, then the tiles in unit index order. A tile holds unitSize rows of
+// wordsPerTileRow words whatever its real size, so edge tiles leave their tails unused.
+// Tile rows are packed to whole words, not cache lines like grid rows: the kernels
+// only write the words a row uses, and readRow stitches bit ranges into the grid anyway.
+static const char BITMAP_CACHE_MAGIC[8] = {'S', 'L', 'I', 'M', 'E', 'B', 'M', 'P'};
+static const int64_t BITMAP_CACHE_VERSION = 2;
+static const uint64_t BITMAP_CACHE_PAGE = 4096;
+static const uint8_t TILE_EMPTY = 0;
+static const uint8_t TILE_FILLING = 1;
+static const uint8_t TILE_VALID = 2;
+
+// OR count bits of src starting at srcBit into dst starting at dstBit
+static void orBitRange(uint64_t* dst, int64_t dstBit, const uint64_t* src, int64_t srcBit, int64_t count) {
+    for (int64_t done = 0; done < count; done += 64) {
+        int64_t bits = std::min<int64_t>(64, count - done);
+        int64_t from = srcBit + done;
+        int64_t fromShift = from & 63;
+        uint64_t word = src[from >> 6] >> fromShift;
+        if (fromShift != 0 && fromShift + bits > 64) {
+            word |= src[(from >> 6) + 1] << (64 - fromShift);
+        }
+        if (bits < 64) {
+            word &= (1ULL << bits) - 1;
+        }
+        int64_t to = dstBit + done;
+        int64_t toShift = to & 63;
+        dst[to >> 6] |= word << toShift;
+        if (toShift != 0 && toShift + bits > 64) {
+            dst[(to >> 6) + 1] |= word >> (64 - toShift);
+        }
+    }
+}
+
+bool BitmapCache::open(const std::string& path, int64_t seed, const SpiralWorkQueue& workQueue) {
+    close();
+    if (workQueue.size() == 0) {
+        std::cerr << "Bitmap cache " << path << ": the search is empty\n";
+        return false;
+    }
+    WorkUnit first = workQueue.unitAt(0);
+    WorkUnit last = workQueue.unitAt(workQueue.size() - 1);
+    worldSeed = seed;
+    minChunkX = first.minX;
+    minChunkZ = first.minZ;
+    maxChunkX = last.maxX;
+    maxChunkZ = last.maxZ;
+    unitChunks = workQueue.unitSize();
+    tilesX = workQueue.unitsAlongX();
+    tilesZ = workQueue.unitsAlongZ();
+    wordsPerTileRow = (unitChunks + 63) / 64;
+    tileBytes = (uint64_t)unitChunks * (uint64_t)wordsPerTileRow * sizeof(uint64_t);
+    tilesOffset = BITMAP_CACHE_PAGE + ((uint64_t)tileCount() + BITMAP_CACHE_PAGE - 1) / BITMAP_CACHE_PAGE * BITMAP_CACHE_PAGE;
+    mappedBytes = tilesOffset + (uint64_t)tileCount() * tileBytes;
+    
+    uint64_t header[9];
+    std::memcpy(&header[0], BITMAP_CACHE_MAGIC, sizeof(uint64_t));
+    header[1] = (uint64_t)BITMAP_CACHE_VERSION;
+    header[2] = (uint64_t)worldSeed;
+    header[3] = (uint64_t)minChunkX;
+    header[4] = (uint64_t)maxChunkX;
+    header[5] = (uint64_t)minChunkZ;
+    header[6] = (uint64_t)maxChunkZ;
+    header[7] = (uint64_t)unitChunks;
+    header[8] = (uint64_t)wordsPerTileRow;
+    
+    // An empty file is new. Extending it leaves a hole, so untouched tiles cost no disk
+    // and read back as zeros.
+    bool created = false;
+    uint64_t existingBytes = 0;
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "Cannot open bitmap cache " << path << " (error " << GetLastError() << ")\n";
+        return false;
+    }
+    fileHandle = file;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        std::cerr << "Cannot read the size of bitmap cache " << path << "\n";
+        close();
+        return false;
+    }
+    existingBytes = (uint64_t)size.QuadPart;
+    created = (existingBytes == 0);
+    if (created) {
+        DWORD returned = 0;
+        DeviceIoControl(file, FSCTL_SET_SPARSE, nullptr, 0, nullptr, 0, &returned, nullptr);
+    }
+    if (created || existingBytes == mappedBytes) {
+        // Mapping past the end of the file extends it
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, (DWORD)(mappedBytes >> 32),
+                                            (DWORD)(mappedBytes & 0xFFFFFFFFULL), nullptr);
+        if (mapping == nullptr) {
+            std::cerr << "Cannot map bitmap cache " << path << " (error " << GetLastError() << ")\n";
+            close();
+            return false;
+        }
+        mappingHandle = mapping;
+        base = (unsigned char*)MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        std::cerr << "Cannot open bitmap cache " << path << ": " << std::strerror(errno) << "\n";
+        return false;
+    }
+    fileDescriptor = fd;
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        std::cerr << "Cannot read the size of bitmap cache " << path << "\n";
+        close();
+        return false;
+    }
+    existingBytes = (uint64_t)status.st_size;
+    created = (existingBytes == 0);
+    if (created && ftruncate(fd, (off_t)mappedBytes) != 0) {
+        std::cerr << "Cannot size bitmap cache " << path << ": " << std::strerror(errno) << "\n";
+        close();
+        return false;
+    }
+    if (created || existingBytes == mappedBytes) {
+        void* view = mmap(nullptr, (size_t)mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        base = (view == MAP_FAILED) ? nullptr : (unsigned char*)view;
+    }
+#endif
+    if (!created && existingBytes != mappedBytes) {
+        std::cerr << "Bitmap cache " << path << " was written for another seed, bounds or unit size\n";
+        close();
+        return false;
+    }
+    if (base == nullptr) {
+        std::cerr << "Cannot map bitmap cache " << path << " (" << mappedBytes << " bytes)\n";
+        close();
+        return false;
+    }
+    
+    if (created) {
+        std::memcpy(base, header, sizeof(header));
+    } else if (std::memcmp(base, header, sizeof(header)) != 0) {
+        std::cerr << "Bitmap cache " << path << " was written for another seed, bounds or unit size\n";
+        close();
+        return false;
+    }
+    
+    validBytes = base + BITMAP_CACHE_PAGE;
+    states.reset(new std::atomic<uint8_t>[tileCount()]);
+    int64_t validCount = 0;
+    for (int64_t tile = 0; tile < tileCount(); tile++) {
+        bool tileValid = validBytes[tile] != 0;
+        states[tile].store(tileValid ? TILE_VALID : TILE_EMPTY, std::memory_order_relaxed);
+        validCount += tileValid;
+    }
+    valid = validCount;
+    filled = 0;
+    return true;
+}
+
+void BitmapCache::close() {
+#ifdef _WIN32
+    if (base != nullptr) {
+        FlushViewOfFile(base, 0);
+        UnmapViewOfFile(base);
+    }
+    if (mappingHandle != nullptr) {
+        CloseHandle((HANDLE)mappingHandle);
+    }
+    if (fileHandle != nullptr) {
+        CloseHandle((HANDLE)fileHandle);
+    }
+#else
+    if (base != nullptr) {
+        msync(base, (size_t)mappedBytes, MS_SYNC);
+        munmap(base, (size_t)mappedBytes);
+    }
+    if (fileDescriptor >= 0) {
+        ::close(fileDescriptor);
+    }
+#endif
+    base = nullptr;
+    validBytes = nullptr;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+    fileDescriptor = -1;
+    states.reset();
+}
+
+uint64_t* BitmapCache::tileRow(int64_t tile, int64_t row) const {
+    return (uint64_t*)(base + tilesOffset + (uint64_t)tile * tileBytes) + row * wordsPerTileRow;
+}
+
+void BitmapCache::computeRow(int64_t startChunkX, int64_t chunkZ, int64_t count, uint64_t* rowBits,
+                             const EngineConfig& engines) const {
+    const SlimeKernel& kernel = slimeKernelFor(engines.simdLevel);
+    auto fillRow = (engines.gridEngine == GridEngine::RowIncremental) ? kernel.fillRowIncremental
+                                                                      : kernel.fillRowBatch;
+    fillRow(startChunkX, chunkZ, count, worldSeed, rowBits);
+}
+
+bool BitmapCache::ensureTile(int64_t tile, const EngineConfig& engines) {
+    uint8_t state = states[tile].load(std::memory_order_acquire);
+    if (state == TILE_VALID) {
+        return true;
+    }
+    if (state != TILE_EMPTY || !states[tile].compare_exchange_strong(state, TILE_FILLING, std::memory_order_acq_rel)) {
+        return states[tile].load(std::memory_order_acquire) == TILE_VALID;
+    }
+    
+    // The tile is ours. Its valid byte is written after its bits, so a later run never
+    // trusts a tile this one was killed halfway through.
+    int64_t tileMinX = minChunkX + (tile / tilesZ) * unitChunks;
+    int64_t tileMinZ = minChunkZ + (tile % tilesZ) * unitChunks;
+    int64_t width = std::min(unitChunks, maxChunkX - tileMinX);
+    int64_t height = std::min(unitChunks, maxChunkZ - tileMinZ);
+    for (int64_t row = 0; row < height; row++) {
+        computeRow(tileMinX, tileMinZ + row, width, tileRow(tile, row), engines);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    validBytes[tile] = 1;
+    states[tile].store(TILE_VALID, std::memory_order_release);
+    valid++;
+    filled++;
+    return true;
+}
+
+void BitmapCache::readRow(int64_t startChunkX, int64_t chunkZ, int64_t count, uint64_t* rowBits,
+                          const EngineConfig& engines) {
+    int64_t endChunkX = startChunkX + count;
+    if (chunkZ < minChunkZ || chunkZ >= maxChunkZ || startChunkX < minChunkX || endChunkX > maxChunkX) {
+        computeRow(startChunkX, chunkZ, count, rowBits, engines);
+        return;
+    }
+    
+    int64_t tileZ = (chunkZ - minChunkZ) / unitChunks;
+    int64_t row = (chunkZ - minChunkZ) % unitChunks;
+    int64_t firstTileX = (startChunkX - minChunkX) / unitChunks;
+    int64_t lastTileX = (endChunkX - 1 - minChunkX) / unitChunks;
+    for (int64_t tileX = firstTileX; tileX <= lastTileX; tileX++) {
+        if (!ensureTile(tileX * tilesZ + tileZ, engines)) {
+            computeRow(startChunkX, chunkZ, count, rowBits, engines);
+            return;
+        }
+    }
+    
+    std::fill(rowBits, rowBits + (count + 63) / 64, 0ULL);
+    for (int64_t tileX = firstTileX; tileX <= lastTileX; tileX++) {
+        int64_t tileMinX = minChunkX + tileX * unitChunks;
+        int64_t from = std::max(startChunkX, tileMinX);
+        int64_t to = std::min(endChunkX, tileMinX + unitChunks);
+        orBitRange(rowBits, from - startChunkX, tileRow(tileX * tilesZ + tileZ, row), from - tileMinX, to - from);
+    }
+}
+
+// SEAM TILING
+
+// Runs of set bits touching each edge of the grid
+static void computeUnitEdges(const SlimeGrid& grid, UnitEdges& edges) {
+    int64_t rows = grid.rows;
+    int64_t cols = grid.cols;
+    int64_t words = grid.usedWords();
+    
+    edges.topDepths.assign(cols, 0);
+    edges.bottomHeights.assign(cols, 0);
+    edges.leftRuns.assign(rows, 0);
+    edges.rightRuns.assign(rows, 0);
+    if (rows == 0 || cols == 0) return;
+    
+    // Columns still alive after ANDing k rows from an edge have a run of at least k.
+    // Runs are short, so this stops after a handful of rows.
+    std::vector<uint64_t> alive;
+    auto verticalRuns = [&](int64_t firstRow, int64_t step, std::vector<uint16_t>& runs) {
+        alive.assign(grid.row(firstRow), grid.row(firstRow) + words);
+        for (int64_t r = firstRow; r >= 0 && r < rows; r += step) {
+            uint64_t any = 0;
+            for (int64_t w = 0; w < words; w++) {
+                if (r != firstRow) alive[w] &= grid.row(r)[w];
+                any |= alive[w];
+                uint64_t bitsLeft = alive[w];
+                while (bitsLeft) {
+                    runs[w * 64 + countTrailingZeros64(bitsLeft)]++;
+                    bitsLeft &= bitsLeft - 1;
+                }
+            }
+            if (any == 0) break;
+        }
+    };
+    verticalRuns(0, 1, edges.topDepths);
+    verticalRuns(rows - 1, -1, edges.bottomHeights);
+    
+    for (int64_t r = 0; r < rows; r++) {
+        const uint64_t* rowBits = grid.row(r);
+        
+        // Trailing ones from column 0; bits past cols are zero, so the run ends in range
+        int64_t left = 0;
+        for (int64_t w = 0; w < words; w++) {
+            if (rowBits[w] != ~0ULL) {
+                left += countTrailingZeros64(~rowBits[w]);
+                break;
+            }
+            left += 64;
+        }
+        edges.leftRuns[r] = (uint16_t)left;
+        
+        int64_t right = 0;
+        while (right < cols && grid.get(r, cols - 1 - right)) {
+            right++;
+        }
+        edges.rightRuns[r] = (uint16_t)right;
+    }
+}
+
+void processUnitSeamed(const WorkUnit& unit,
+                       int64_t worldSeed,
+                       int64_t minimumRectDimension,
+                       int64_t minimumArea,
+                       UnitEdges& edges,
+                       std::vector<Rectangle>& unitResults,
+                       bool scanRectangles,
+                       const EngineConfig& engines,
+                       bool debugMode,
+                       UnitArena* arena) {
+    StageTimer timer(Stage::Seams);
+    UnitArena localArena;
+    UnitArena& scratch = (arena != nullptr) ? *arena : localArena;
+    SlimeGrid& grid = scratch.grid(unit.maxZ - unit.minZ, unit.maxX - unit.minX);
+    if (scanRectangles && grid.rows >= minimumRectDimension && grid.cols >= minimumRectDimension) {
+        fillAndScanGrid(grid, unit.minX, unit.minZ, worldSeed, minimumRectDimension, minimumArea, engines,
+                        unitResults, debugMode, scratch);
+    } else {
+        fillSlimeGrid(grid, unit.minX, unit.minZ, worldSeed, engines);
+    }
+    computeUnitEdges(grid, edges);
+}
+
+// Indices of the units in the 3x3 block around a unit, clipped to the unit grid
+static int64_t unitBlock(int64_t index, int64_t unitsX, int64_t unitsZ, int64_t block[9]) {
+    int64_t unitX = index / unitsZ;
+    int64_t unitZ = index % unitsZ;
+    int64_t count = 0;
+    for (int64_t x = std::max<int64_t>(unitX - 1, 0); x <= std::min(unitX + 1, unitsX - 1); x++) {
+        for (int64_t z = std::max<int64_t>(unitZ - 1, 0); z <= std::min(unitZ + 1, unitsZ - 1); z++) {
+            block[count++] = x * unitsZ + z;
+        }
+    }
+    return count;
+}
+
+SeamTracker::SeamTracker(const SpiralWorkQueue& workQueue, const WorkProgress& progress)
+    : workQueue(workQueue), progress(progress) {
+}
+
+SeamTracker::UnitState& SeamTracker::stateFor(int64_t index) {
+    auto found = units.find(index);
+    if (found != units.end()) {
+        return found->second;
+    }
+    
+    // Units completed before a resume are never resolved again and don't read edges
+    int64_t block[9];
+    int64_t count = unitBlock(index, workQueue.unitsAlongX(), workQueue.unitsAlongZ(), block);
+    UnitState& state = units[index];
+    state.waitingOn = count;
+    for (int64_t i = 0; i < count; i++) {
+        if (!progress.isDone(block[i])) {
+            state.edgeReaders++;
+        }
+    }
+    return state;
+}
+
+bool SeamTracker::needsEdges(int64_t index) const {
+    int64_t block[9];
+    int64_t count = unitBlock(index, workQueue.unitsAlongX(), workQueue.unitsAlongZ(), block);
+    for (int64_t i = 0; i < count; i++) {
+        if (!progress.isDone(block[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SeamTracker::publish(int64_t index, std::shared_ptr<const UnitEdges> edges,
+                          std::vector<Rectangle>&& rectangles, std::vector<int64_t>& readyUnits) {
+    int64_t block[9];
+    int64_t count = unitBlock(index, workQueue.unitsAlongX(), workQueue.unitsAlongZ(), block);
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    UnitState& state = stateFor(index);
+    state.edges = std::move(edges);
+    state.rectangles = std::move(rectangles);
+    state.published = true;
+    
+    for (int64_t i = 0; i < count; i++) {
+        if (progress.isDone(block[i])) continue;
+        if (--stateFor(block[i]).waitingOn == 0) {
+            readyUnits.push_back(block[i]);
+        }
+    }
+}
+
+int64_t SeamTracker::trackedUnits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return (int64_t)units.size();
+}
+
+void SeamTracker::resolve(int64_t index, int64_t minimumRectDimension, int64_t minimumArea,
+                          std::vector<Rectangle>& results) {
+    int64_t unitsX = workQueue.unitsAlongX();
+    int64_t unitsZ = workQueue.unitsAlongZ();
+    int64_t unitX = index / unitsZ;
+    int64_t unitZ = index % unitsZ;
+    WorkUnit unit = workQueue.unitAt(index);
+    
+    // Edges of the 3x3 block, neighbour[dx + 1][dz + 1]; null outside the unit grid
+    std::shared_ptr<const UnitEdges> neighbour[3][3];
+    std::vector<Rectangle> rectangles;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int64_t dx = -1; dx <= 1; dx++) {
+            for (int64_t dz = -1; dz <= 1; dz++) {
+                int64_t x = unitX + dx;
+                int64_t z = unitZ + dz;
+                if (x >= 0 && x < unitsX && z >= 0 && z < unitsZ) {
+                    neighbour[dx + 1][dz + 1] = units.at(x * unitsZ + z).edges;
+                }
+            }
+        }
+        rectangles = std::move(units.at(index).rectangles);
+    }
+    
+    // Runs along the horizontal line through the block's columns: up(x) ends on the row
+    // above this unit's first row, down(x) starts on its first row. Likewise left(z) ends
+    // on the column before this unit's first column and right(z) starts on it.
+    // Columns and rows outside the block read as 0.
+    auto lineRun = [&](int64_t position, int64_t origin, int64_t end, int64_t column, int64_t row,
+                       bool alongX, std::vector<uint16_t> UnitEdges::*runs) -> int64_t {
+        int64_t d = 0;
+        int64_t offset = position - origin;
+        if (position < origin) {
+            d = -1;
+            offset = position - (origin - workQueue.unitSize());
+        } else if (position >= end) {
+            d = 1;
+            offset = position - end;
+        }
+        const UnitEdges* edges = alongX ? neighbour[d + 1][row + 1].get() : neighbour[column + 1][d + 1].get();
+        if (edges == nullptr || offset < 0 || offset >= (int64_t)(edges->*runs).size()) {
+            return 0;
+        }
+        return (edges->*runs)[offset];
+    };
+    auto up = [&](int64_t x) { return lineRun(x, unit.minX, unit.maxX, 0, -1, true, &UnitEdges::bottomHeights); };
+    auto down = [&](int64_t x) { return lineRun(x, unit.minX, unit.maxX, 0, 0, true, &UnitEdges::topDepths); };
+    auto left = [&](int64_t z) { return lineRun(z, unit.minZ, unit.maxZ, -1, 0, false, &UnitEdges::rightRuns); };
+    auto right = [&](int64_t z) { return lineRun(z, unit.minZ, unit.maxZ, 0, 0, false, &UnitEdges::leftRuns); };
+    
+    auto qualifies = [&](int64_t width, int64_t height) {
+        return width >= minimumRectDimension && height >= minimumRectDimension && width * height >= minimumArea;
+    };
+    
+    // Rectangles maximal inside the unit are final unless a neighbour extends them
+    for (const Rectangle& rect : rectangles) {
+        bool extends = false;
+        if (rect.z == unit.minZ && neighbour[1][0]) {
+            extends = true;
+            for (int64_t x = rect.x; x < rect.x + rect.width && extends; x++) extends = up(x) > 0;
+        }
+        if (!extends && rect.z + rect.height == unit.maxZ && neighbour[1][2]) {
+            extends = true;
+            for (int64_t x = rect.x; x < rect.x + rect.width && extends; x++) {
+                extends = neighbour[1][2]->topDepths[x - unit.minX] > 0;
+            }
+        }
+        if (!extends && rect.x == unit.minX && neighbour[0][1]) {
+            extends = true;
+            for (int64_t z = rect.z; z < rect.z + rect.height && extends; z++) extends = left(z) > 0;
+        }
+        if (!extends && rect.x + rect.width == unit.maxX && neighbour[2][1]) {
+            extends = true;
+            for (int64_t z = rect.z; z < rect.z + rect.height && extends; z++) {
+                extends = neighbour[2][1]->leftRuns[z - unit.minZ] > 0;
+            }
+        }
+        if (!extends && qualifies(rect.width, rect.height)) {
+            results.push_back(rect);
         }
     }
     
-    // Build height matrix for histogram-based algorithm
-    std::vector<std::vector<int64_t>> heights(rows, std::vector<int64_t>(cols, 0));
-    
-    for (int64_t i = 0; i < rows; i++) {
-        for (int64_t j = 0; j < cols; j++) {
-            if (grid[i][j]) {
-                heights[i][j] = (i == 0) ? 1 : heights[i-1][j] + 1;
+    // Top seam: every maximal rectangle crossing it spans the minimum up and down runs
+    // of its columns, so it only needs to be maximal sideways. This unit owns those
+    // whose first column is its own; they may reach into the next unit column.
+    if (neighbour[1][0]) {
+        for (int64_t a = unit.minX; a < unit.maxX; a++) {
+            int64_t upRun = up(a);
+            int64_t downRun = down(a);
+            for (int64_t b = a; upRun > 0 && downRun > 0; ) {
+                if (qualifies(b - a + 1, upRun + downRun) &&
+                    !(up(a - 1) >= upRun && down(a - 1) >= downRun) &&
+                    !(up(b + 1) >= upRun && down(b + 1) >= downRun)) {
+                    results.push_back(makeRectangle(a, unit.minZ - upRun, b - a + 1, upRun + downRun));
+                }
+                b++;
+                upRun = std::min(upRun, up(b));
+                downRun = std::min(downRun, down(b));
             }
         }
     }
     
-    // Find all maximal rectangles using histogram algorithm
-    for (int64_t row = 0; row < rows; row++) {
-        std::vector<int64_t>& height = heights[row];
-        
-        // For each position, find all maximal rectangles ending at this row
-        for (int64_t i = 0; i < cols; i++) {
-            if (height[i] == 0) continue;
-            
-            int64_t minHeight = height[i];
-            
-            // Extend rectangle to the right
-            for (int64_t j = i; j < cols && height[j] > 0; j++) {
-                minHeight = std::min(minHeight, height[j]);
-                int64_t width = j - i + 1;
-                int64_t h = minHeight;
-                
-                // Report all rectangles that meet minimum size requirement
-                if (width >= minimumRectDimension && h >= minimumRectDimension) {
-                    Rectangle rect;
-                    rect.x = offsetX + i;
-                    rect.z = offsetZ + (row - h + 1);
-                    rect.width = width;
-                    rect.height = h;
-                    rect.area = width * h;
-                    
-                    // Calculate distance from spawn (0,0) using rectangle center in BLOCK coordinates
-                    int64_t centerChunkX = rect.x + rect.width / 2;
-                    int64_t centerChunkZ = rect.z + rect.height / 2;
-                    int64_t centerBlockX = centerChunkX * 16;
-                    int64_t centerBlockZ = centerChunkZ * 16;
-                    rect.distanceSquared = centerBlockX * centerBlockX + centerBlockZ * centerBlockZ;
-                    
-                    if (debugMode && rect.x == 1495 && rect.z == 8282 && rect.width == 3 && rect.height == 3) {
-                        std::lock_guard<std::mutex> lock(resultsMutex);
-                        std::cout << "[DEBUG] Found target 3x3! offsetX=" << offsetX << " offsetZ=" << offsetZ 
-                                  << " i=" << i << " row=" << row << " h=" << h << "\n";
-                    }
-                    
-                    std::lock_guard<std::mutex> lock(resultsMutex);
-                    foundRectangles.insert(rect);
+    // Left seam, for rectangles that stay within this unit row (the ones crossing a
+    // horizontal seam as well belong to that seam). Maximal means not extendable up or
+    // down, where the row above or below may belong to the next unit row.
+    if (neighbour[0][1]) {
+        for (int64_t a = unit.minZ; a < unit.maxZ; a++) {
+            int64_t leftRun = left(a);
+            int64_t rightRun = right(a);
+            for (int64_t b = a; b < unit.maxZ && leftRun > 0 && rightRun > 0; ) {
+                if (qualifies(leftRun + rightRun, b - a + 1) &&
+                    !(left(a - 1) >= leftRun && right(a - 1) >= rightRun) &&
+                    !(left(b + 1) >= leftRun && right(b + 1) >= rightRun)) {
+                    results.push_back(makeRectangle(unit.minX - leftRun, a, leftRun + rightRun, b - a + 1));
+                }
+                b++;
+                if (b < unit.maxZ) {
+                    leftRun = std::min(leftRun, left(b));
+                    rightRun = std::min(rightRun, right(b));
                 }
             }
         }
     }
+    
+    // Release edges nobody in the block will read again
+    int64_t block[9];
+    int64_t count = unitBlock(index, unitsX, unitsZ, block);
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int64_t i = 0; i < count; i++) {
+        auto found = units.find(block[i]);
+        if (--found->second.edgeReaders == 0 && found->second.published) {
+            units.erase(found);
+        }
+    }
 }
 
-// Process a rectangular region with overlap padding to catch boundary rectangles
-void processRegion(int64_t minX, int64_t maxX, int64_t minZ, int64_t maxZ,
-                   int64_t worldSeed,
-                   int64_t minimumRectDimension,
-                   int64_t searchMinX, int64_t searchMaxX, int64_t searchMinZ, int64_t searchMaxZ,
-                   std::mutex& resultsMutex,
-                   std::set<Rectangle>& foundRectangles,
-                   std::atomic<int64_t>& chunksProcessed,
-                   bool debugMode) {
-    
-    if (debugMode) {
-        bool isDebugRegion = (minX <= 1495 && maxX > 1495 && minZ <= 8284 && maxZ > 8284);
-        if (isDebugRegion) {
-            std::lock_guard<std::mutex> lock(resultsMutex);
-            std::cout << "[DEBUG] processRegion input: X[" << minX << "-" << maxX << "] Z[" << minZ << "-" << maxZ << "]\n";
-            std::cout << "[DEBUG] SEARCH bounds (chunks): X[" << (searchMinX/16) << "-" << (searchMaxX/16) 
-                      << "] Z[" << (searchMinZ/16) << "-" << (searchMaxZ/16) << "]\n";
+// WORK GENERATION
+
+// Parse a Linux cpulist such as "0-15,32-47"
+static std::vector<int> parseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream list(text);
+    std::string part;
+    while (std::getline(list, part, ',')) {
+        int first = 0, last = 0;
+        char dash = 0;
+        std::stringstream range(part);
+        if (!(range >> first)) continue;
+        last = first;
+        if (range >> dash >> last) {
+            if (dash != '-') last = first;
+        }
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
         }
     }
+    return cpus;
+}
+
+std::vector<std::vector<int>> detectNumaNodes() {
+    std::vector<std::vector<int>> nodes;
+#ifdef _WIN32
+    ULONG highestNode = 0;
+    if (GetNumaHighestNodeNumber(&highestNode)) {
+        for (ULONG node = 0; node <= highestNode; node++) {
+            GROUP_AFFINITY affinity = {};
+            if (!GetNumaNodeProcessorMaskEx((USHORT)node, &affinity) || affinity.Mask == 0) {
+                continue;
+            }
+            std::vector<int> cpus;
+            for (int bit = 0; bit < 64; bit++) {
+                if ((affinity.Mask >> bit) & 1) {
+                    cpus.push_back(affinity.Group * 64 + bit);
+                }
+            }
+            nodes.push_back(cpus);
+        }
+    }
+#elif defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool haveAllowed = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    auto usable = [&](int cpu) {
+        return !haveAllowed || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed));
+    };
     
-    // Add padding to ensure rectangles on boundaries aren't missed
-    int64_t paddedMinX = minX - minimumRectDimension + 1;
-    int64_t paddedMaxX = maxX + minimumRectDimension - 1;
-    int64_t paddedMinZ = minZ - minimumRectDimension + 1;
-    int64_t paddedMaxZ = maxZ + minimumRectDimension - 1;
-    
-    // Clamp to search bounds (convert block bounds to chunk bounds)
-    int64_t searchMinChunkX = searchMinX / 16;
-    int64_t searchMaxChunkX = searchMaxX / 16;
-    int64_t searchMinChunkZ = searchMinZ / 16;
-    int64_t searchMaxChunkZ = searchMaxZ / 16;
-    
-    paddedMinX = std::max(paddedMinX, searchMinChunkX);
-    paddedMaxX = std::min(paddedMaxX, searchMaxChunkX);
-    paddedMinZ = std::max(paddedMinZ, searchMinChunkZ);
-    paddedMaxZ = std::min(paddedMaxZ, searchMaxChunkZ);
-    
-    int64_t width = paddedMaxX - paddedMinX;
-    int64_t height = paddedMaxZ - paddedMinZ;
-    
-    if (width < minimumRectDimension || height < minimumRectDimension) {
-        return;
+    std::vector<std::pair<int, std::vector<int>>> found;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+            name.find_first_not_of("0123456789", 4) != std::string::npos) {
+            continue;
+        }
+        std::ifstream file(entry.path() / "cpulist");
+        std::string text;
+        std::getline(file, text);
+        std::vector<int> cpus;
+        for (int cpu : parseCpuList(text)) {
+            if (usable(cpu)) cpus.push_back(cpu);
+        }
+        if (!cpus.empty()) {
+            found.push_back({std::stoi(name.substr(4)), cpus});
+        }
+    }
+    std::sort(found.begin(), found.end());
+    for (auto& node : found) {
+        nodes.push_back(std::move(node.second));
+    }
+    if (nodes.empty() && haveAllowed) {
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+        }
+        nodes.push_back(cpus);
+    }
+#endif
+    if (nodes.empty()) {
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < (int)std::max(1u, std::thread::hardware_concurrency()); cpu++) {
+            cpus.push_back(cpu);
+        }
+        nodes.push_back(cpus);
+    }
+    return nodes;
+}
+
+std::vector<WorkerPlacement> planWorkerPlacement(int64_t threads, const std::vector<std::vector<int>>& nodes) {
+    std::vector<WorkerPlacement> slots;
+    for (size_t node = 0; node < nodes.size(); node++) {
+        for (int cpu : nodes[node]) {
+            slots.push_back({cpu, (int)node});
+        }
+    }
+    std::vector<WorkerPlacement> placement((size_t)std::max<int64_t>(threads, 0));
+    for (size_t t = 0; t < placement.size() && !slots.empty(); t++) {
+        placement[t] = slots[t % slots.size()];
     }
+    return placement;
+}
+
+bool pinCurrentThread(int cpu) {
+    if (cpu < 0) {
+        return false;
+    }
+#ifdef _WIN32
+    GROUP_AFFINITY affinity = {};
+    affinity.Group = (WORD)(cpu / 64);
+    affinity.Mask = (KAFFINITY)1 << (cpu % 64);
+    return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+#elif defined(__linux__)
+    if (cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+SpiralWorkQueue::SpiralWorkQueue(int64_t searchMinX, int64_t searchMaxX, int64_t searchMinZ, int64_t searchMaxZ,
+                                 int64_t unitSize)
+    : unitChunks(unitSize) {
+    // Convert block bounds to chunk bounds
+    minChunkX = searchMinX / 16;
+    maxChunkX = searchMaxX / 16;
+    minChunkZ = searchMinZ / 16;
+    maxChunkZ = searchMaxZ / 16;
     
-    // Build slime chunk grid using AVX-512 vectorized detection
-    std::vector<std::vector<bool>> grid(height, std::vector<bool>(width, false));
+    unitsX = std::max<int64_t>(0, (maxChunkX - minChunkX + unitChunks - 1) / unitChunks);
+    unitsZ = std::max<int64_t>(0, (maxChunkZ - minChunkZ + unitChunks - 1) / unitChunks);
     
-    // Batch arrays for AVX-512 16-way processing
-    alignas(64) int64_t chunkXBatch[16];
-    alignas(64) int64_t chunkZBatch[16];
-    alignas(64) bool resultsBatch[16];
-    int64_t gridXBatch[16];
-    int64_t gridZBatch[16];
+    // Unit containing the origin, or the nearest one when the origin is outside the bounds
+    centerX = std::clamp<int64_t>(minChunkX < 0 ? -minChunkX / unitChunks : 0, 0, std::max<int64_t>(0, unitsX - 1));
+    centerZ = std::clamp<int64_t>(minChunkZ < 0 ? -minChunkZ / unitChunks : 0, 0, std::max<int64_t>(0, unitsZ - 1));
     
-    int64_t batchIdx = 0;
+    int64_t maxRing = std::max({centerX, unitsX - 1 - centerX, centerZ, unitsZ - 1 - centerZ});
+    spiralCells = (unitsX > 0 && unitsZ > 0) ? (2 * maxRing + 1) * (2 * maxRing + 1) : 0;
+}
+
+bool SpiralWorkQueue::next(WorkUnit& unit) {
+    // Off-center bounds leave part of each ring outside; those cells cost one claim each
+    while (true) {
+        int64_t spiralIndex = cursor.fetch_add(1, std::memory_order_relaxed);
+        if (spiralIndex >= spiralCells) {
+            return false;
+        }
+        if (unitAtSpiral(spiralIndex, unit)) {
+            return true;
+        }
+    }
+}
+
+void SpiralWorkQueue::enableStealing(const std::vector<WorkerPlacement>& placement) {
+    int64_t threads = (int64_t)placement.size();
+    threadRanges.reset(new ThreadRange[(size_t)std::max<int64_t>(threads, 1)]);
     
-    for (int64_t z = 0; z < height; z++) {
-        for (int64_t x = 0; x < width; x++) {
-            int64_t chunkX = paddedMinX + x;
-            int64_t chunkZ = paddedMinZ + z;
-            
-            chunkXBatch[batchIdx] = chunkX;
-            chunkZBatch[batchIdx] = chunkZ;
-            gridXBatch[batchIdx] = x;
-            gridZBatch[batchIdx] = z;
-            batchIdx++;
-            
-            // Process batch of 16 chunks with AVX-512
-            if (batchIdx == 16) {
-                isSlimeChunkVec16(chunkXBatch, chunkZBatch, worldSeed, resultsBatch);
-                
-                for (int64_t i = 0; i < 16; i++) {
-                    grid[gridZBatch[i]][gridXBatch[i]] = resultsBatch[i];
+    // Workers on the same node first, then the rest, each by distance in thread id
+    victimOrder.assign((size_t)threads, {});
+    for (int64_t t = 0; t < threads; t++) {
+        std::vector<int64_t>& victims = victimOrder[t];
+        for (int pass = 0; pass < 2; pass++) {
+            for (int64_t distance = 1; distance < threads; distance++) {
+                for (int64_t victim : {(t + distance) % threads, (t - distance + threads) % threads}) {
+                    bool sameNode = placement[victim].node == placement[t].node;
+                    if (sameNode == (pass == 0) &&
+                        std::find(victims.begin(), victims.end(), victim) == victims.end()) {
+                        victims.push_back(victim);
+                    }
                 }
-                
-                batchIdx = 0;
             }
         }
     }
-    
-    // Process remaining chunks (less than 16)
-    if (batchIdx > 0) {
-        // Pad with dummy values
-        for (int64_t i = batchIdx; i < 16; i++) {
-            chunkXBatch[i] = 0;
-            chunkZBatch[i] = 0;
+}
+
+bool SpiralWorkQueue::next(WorkUnit& unit, int64_t thread) {
+    if (threadRanges == nullptr) {
+        return next(unit);
+    }
+    ThreadRange& own = threadRanges[thread];
+    while (true) {
+        int64_t spiralIndex = -1;
+        {
+            std::lock_guard<std::mutex> lock(own.lock);
+            if (own.begin < own.end) {
+                spiralIndex = own.begin++;
+            }
         }
-        
-        isSlimeChunkVec16(chunkXBatch, chunkZBatch, worldSeed, resultsBatch);
-        
-        for (int64_t i = 0; i < batchIdx; i++) {
-            grid[gridZBatch[i]][gridXBatch[i]] = resultsBatch[i];
+        if (spiralIndex < 0) {
+            if (!refill(thread)) {
+                return false;
+            }
+        } else if (unitAtSpiral(spiralIndex, unit)) {
+            return true;
         }
     }
-    
-    // Find rectangles in this grid
-    findMaximalRectangles(grid, 0, height, paddedMinX, paddedMinZ, minimumRectDimension, resultsMutex, foundRectangles, debugMode);
-    
-    // Only count the non-padded region for progress tracking
-    chunksProcessed += (maxX - minX) * (maxZ - minZ);
 }
 
-// Generate work queue sorted by distance from origin
-void generateWorkQueue(int64_t searchMinX, int64_t searchMaxX, int64_t searchMinZ, int64_t searchMaxZ,
-                       std::vector<std::pair<std::pair<int64_t, int64_t>, std::pair<int64_t, int64_t>>>& workQueue) {
-    struct WorkUnit {
-        int64_t minX, maxX, minZ, maxZ;
-        int64_t distSquared;
-    };
+// A worker's range is only ever emptied by the worker itself or split by a thief, so
+// a unit is never lost: if every victim looks empty, what is left is in ranges whose
+// owners are still running.
+bool SpiralWorkQueue::refill(int64_t thread) {
+    ThreadRange& own = threadRanges[thread];
+    int64_t begin = cursor.fetch_add(STEAL_BLOCK_UNITS, std::memory_order_relaxed);
+    int64_t end = std::min(begin + STEAL_BLOCK_UNITS, spiralCells);
     
-    std::vector<WorkUnit> units;
+    if (begin >= spiralCells) {
+        begin = end = 0;
+        for (int64_t victim : victimOrder[thread]) {
+            ThreadRange& other = threadRanges[victim];
+            std::lock_guard<std::mutex> lock(other.lock);
+            int64_t remaining = other.end - other.begin;
+            if (remaining > 0) {
+                // The owner keeps the cells nearer the origin
+                end = other.end;
+                begin = other.end - (remaining + 1) / 2;
+                other.end = begin;
+                break;
+            }
+        }
+        if (begin == end) {
+            return false;
+        }
+        stealCount.fetch_add(1, std::memory_order_relaxed);
+    }
     
-    // Convert block bounds to chunk bounds
-    int64_t searchMinChunkX = searchMinX / 16;
-    int64_t searchMaxChunkX = searchMaxX / 16;
-    int64_t searchMinChunkZ = searchMinZ / 16;
-    int64_t searchMaxChunkZ = searchMaxZ / 16;
+    std::lock_guard<std::mutex> lock(own.lock);
+    own.begin = begin;
+    own.end = end;
+    return true;
+}
+
+bool SpiralWorkQueue::unitAtSpiral(int64_t spiralIndex, WorkUnit& unit) const {
+    // Rings before ring r hold (2r - 1)^2 cells
+    int64_t ring = 0;
+    int64_t offset = 0;
+    if (spiralIndex > 0) {
+        int64_t root = (int64_t)std::sqrt((double)spiralIndex);
+        while (root * root > spiralIndex) root--;
+        while ((root + 1) * (root + 1) <= spiralIndex) root++;
+        ring = (root + 1) / 2;
+        offset = spiralIndex - (2 * ring - 1) * (2 * ring - 1);
+    }
     
-    // Generate all work units (in chunks)
-    for (int64_t x = searchMinChunkX; x < searchMaxChunkX; x += WORK_UNIT_SIZE) {
-        for (int64_t z = searchMinChunkZ; z < searchMaxChunkZ; z += WORK_UNIT_SIZE) {
-            WorkUnit unit;
-            unit.minX = x;
-            unit.maxX = std::min(x + WORK_UNIT_SIZE, searchMaxChunkX);
-            unit.minZ = z;
-            unit.maxZ = std::min(z + WORK_UNIT_SIZE, searchMaxChunkZ);
-            
-            // Calculate distance from origin (center of work unit)
-            int64_t centerX = (unit.minX + unit.maxX) / 2;
-            int64_t centerZ = (unit.minZ + unit.maxZ) / 2;
-            unit.distSquared = centerX * centerX + centerZ * centerZ;
-            
-            units.push_back(unit);
-        }
+    // Each side of ring r is the cells (r, t) for t in (-r, r], rotated by 90 degrees per
+    // side. Offsets run t = 0 on all four sides, then t = +1, -1, +2, -2, ... so the
+    // corners (t = r) come last.
+    int64_t side = 0;
+    int64_t t = 0;
+    if (offset < 4) {
+        side = offset;
+    } else {
+        int64_t pairOffset = offset - 4;
+        int64_t magnitude = pairOffset / 8 + 1;
+        t = (pairOffset % 8 < 4) ? magnitude : -magnitude;
+        side = pairOffset % 4;
     }
     
-    // Sort by distance from origin (closest first)
-    std::sort(units.begin(), units.end(), [](const WorkUnit& a, const WorkUnit& b) {
-        return a.distSquared < b.distSquared;
-    });
+    int64_t dx = 0, dz = 0;
+    switch (side) {
+        case 0: dx = ring;  dz = t;     break;
+        case 1: dx = -t;    dz = ring;  break;
+        case 2: dx = -ring; dz = -t;    break;
+        case 3: dx = t;     dz = -ring; break;
+    }
     
-    // Convert to work queue
-    workQueue.reserve(units.size());
-    for (const auto& unit : units) {
-        workQueue.push_back({{unit.minX, unit.maxX}, {unit.minZ, unit.maxZ}});
+    int64_t unitX = centerX + dx;
+    int64_t unitZ = centerZ + dz;
+    if (unitX < 0 || unitX >= unitsX || unitZ < 0 || unitZ >= unitsZ) {
+        return false;
     }
+    unit = unitAt(unitX * unitsZ + unitZ);
+    return true;
+}
+
+WorkUnit SpiralWorkQueue::unitAt(int64_t index) const {
+    int64_t unitX = index / unitsZ;
+    int64_t unitZ = index % unitsZ;
+    
+    WorkUnit unit;
+    unit.minX = minChunkX + unitX * unitChunks;
+    unit.maxX = std::min(unit.minX + unitChunks, maxChunkX);
+    unit.minZ = minChunkZ + unitZ * unitChunks;
+    unit.maxZ = std::min(unit.minZ + unitChunks, maxChunkZ);
+    unit.index = index;
+    return unit;
 }
 
 // Worker thread - grabs work from queue dynamically
+// Pin a worker to its CPU before it allocates anything, so its memory is local to it
+static void pinWorker(const EngineConfig& engines, int64_t threadId) {
+    if (engines.placement != nullptr && threadId < (int64_t)engines.placement->size()) {
+        pinCurrentThread((*engines.placement)[threadId].cpu);
+    }
+}
+
 void workerThread(int64_t threadId, int64_t numThreads,
                   int64_t worldSeed,
                   int64_t minimumRectDimension,
                   int64_t searchMinX, int64_t searchMaxX, int64_t searchMinZ, int64_t searchMaxZ,
-                  std::mutex& resultsMutex,
-                  std::set<Rectangle>& foundRectangles,
+                  RectangleStore& results,
                   std::atomic<bool>& pauseFlag,
                   std::atomic<int64_t>& chunksProcessed,
                   std::atomic<int64_t>& maxDistanceReached,
-                  std::vector<std::pair<std::pair<int64_t, int64_t>, std::pair<int64_t, int64_t>>>& workQueue,
-                  std::atomic<int64_t>& workQueueIndex,
+                  SpiralWorkQueue& workQueue,
+                  WorkProgress& progress,
+                  SeamTracker& seams,
+                  const EngineConfig& engines,
                   bool debugMode) {
+    pinWorker(engines, threadId);
+    
+    // Rectangles found by this thread since the last merge into the shared store, and the
+    // units that produced them. Units are only marked complete once merged.
+    std::vector<Rectangle> localResults;
+    std::vector<int64_t> pendingUnits;
+    std::vector<int64_t> readyUnits;
+    int64_t scannedShortSide = 0;
+    bindStageCounters(engines.metrics != nullptr ? &engines.metrics->forThread(threadId) : nullptr);
+    
+    // Scratch for every unit this thread scans, sized for a padded unit at the starting
+    // dimension. Only largest mode's growing padding makes it grow later. It is allocated
+    // and first touched after pinning, so its pages come from this thread's node.
+    int64_t arenaSide = engines.seamTiling() ? workQueue.unitSize()
+                                             : paddedUnitSide(workQueue.unitSize(), minimumRectDimension);
+    UnitArena arena(arenaSide, arenaSide, engines.simdLevel);
+    
     while (!pauseFlag) {
-        // Atomically grab next work unit
-        int64_t idx = workQueueIndex.fetch_add(1, std::memory_order_relaxed);
-        
-        if (idx >= (int64_t)workQueue.size()) {
+        // Grab the next work unit, from another worker once the spiral is handed out
+        WorkUnit work;
+        if (!workQueue.next(work, threadId)) {
             break;
         }
         
-        auto& work = workQueue[idx];
-        int64_t minX = work.first.first;
-        int64_t maxX = work.first.second;
-        int64_t minZ = work.second.first;
-        int64_t maxZ = work.second.second;
+        // Finished before a resume. With seam tiling its edges are still recomputed while
+        // a neighbouring unit needs them.
+        bool finished = progress.isDone(work.index);
+        if (finished && !(engines.seamTiling() && seams.needsEdges(work.index))) {
+            continue;
+        }
+        
+        int64_t minX = work.minX;
+        int64_t maxX = work.maxX;
+        int64_t minZ = work.minZ;
+        int64_t maxZ = work.maxZ;
         
         if (debugMode) {
             if (minX <= 1495 && maxX > 1495 && minZ <= 8282 && maxZ > 8282) {
-                std::lock_guard<std::mutex> lock(resultsMutex);
+                std::lock_guard<std::mutex> lock(debugOutputMutex);
                 std::cout << "[DEBUG] Processing work unit containing test 3x3: X[" << minX << "-" << maxX 
                           << "] Z[" << minZ << "-" << maxZ << "]\n";
             }
         }
         
-        processRegion(minX, maxX, minZ, maxZ, worldSeed, minimumRectDimension,
-                     searchMinX, searchMaxX, searchMinZ, searchMaxZ,
-                     resultsMutex, foundRectangles, chunksProcessed, debugMode);
+        // In largest mode every new best raises the dimension this unit searches for, and with
+        // it the padding and the square prefilter's N. Ties are kept so a longer rectangle with
+        // the same shorter side still gets reported. Seam tiling settles units late, so the
+        // rectangles of scanned but unsettled units count too: growing one across a seam
+        // never makes its shorter side smaller.
+        int64_t unitDimension = minimumRectDimension;
+        if (engines.searchMode == SearchMode::Largest) {
+            unitDimension = std::max(unitDimension, std::max(results.bestShortSide(), scannedShortSide));
+            for (const Rectangle& rect : localResults) {
+                unitDimension = std::max(unitDimension, std::min(rect.width, rect.height));
+            }
+        }
+        
+        if (engines.seamTiling()) {
+            // Scan the unit on its own and publish its edges. Rectangles of the units whose
+            // whole neighbourhood is now published are settled here, by whichever thread
+            // published last; a unit only becomes pending once it's settled.
+            auto edges = std::make_shared<UnitEdges>();
+            std::vector<Rectangle> unitResults;
+            processUnitSeamed(work, worldSeed, unitDimension, results.admissionArea(), *edges,
+                              unitResults, !finished, engines, debugMode, &arena);
+            if (!finished) {
+                chunksProcessed += (maxX - minX) * (maxZ - minZ);
+            }
+            for (const Rectangle& rect : unitResults) {
+                scannedShortSide = std::max(scannedShortSide, std::min(rect.width, rect.height));
+            }
+            
+            StageTimer timer(Stage::Seams);
+            readyUnits.clear();
+            seams.publish(work.index, std::move(edges), std::move(unitResults), readyUnits);
+            for (int64_t unit : readyUnits) {
+                seams.resolve(unit, unitDimension, results.admissionArea(), localResults);
+                pendingUnits.push_back(unit);
+            }
+        } else {
+            processRegion(minX, maxX, minZ, maxZ, worldSeed, unitDimension, results.admissionArea(),
+                         searchMinX, searchMaxX, searchMinZ, searchMaxZ,
+                         localResults, chunksProcessed, engines, debugMode, &arena);
+            pendingUnits.push_back(work.index);
+        }
+        
+        // Merge at the work-unit boundary. While another thread holds the lock the merge
+        // is put off to a later unit, until the buffer grows past RESULT_BUFFER_FLUSH_SIZE.
+        if (results.insertBatch(localResults, (int64_t)localResults.size() >= RESULT_BUFFER_FLUSH_SIZE)) {
+            for (int64_t unit : pendingUnits) {
+                progress.markDone(unit);
+            }
+            pendingUnits.clear();
+        }
         
         // Update max distance
         int64_t centerX = (minX + maxX) / 2;
@@ -414,17 +3406,278 @@ void workerThread(int64_t threadId, int64_t numThreads,
                !maxDistanceReached.compare_exchange_weak(currentMax, dist, std::memory_order_relaxed)) {
         }
     }
+    
+    results.insertBatch(localResults, true);
+    for (int64_t unit : pendingUnits) {
+        progress.markDone(unit);
+    }
+    bindStageCounters(nullptr);
+}
+
+void multiSeedWorkerThread(int64_t threadId,
+                           const std::vector<int64_t>& worldSeeds,
+                           int64_t minimumRectDimension,
+                           int64_t searchMinX, int64_t searchMaxX, int64_t searchMinZ, int64_t searchMaxZ,
+                           std::vector<std::unique_ptr<RectangleStore>>& results,
+                           std::atomic<bool>& pauseFlag,
+                           std::atomic<int64_t>& chunksProcessed,
+                           std::atomic<int64_t>& maxDistanceReached,
+                           SpiralWorkQueue& workQueue,
+                           WorkProgress& progress,
+                           const EngineConfig& engines,
+                           bool debugMode) {
+    pinWorker(engines, threadId);
+    
+    // One buffer per seed. A unit is only marked complete once every seed's buffer has
+    // been merged, so a checkpoint never holds a unit with some seeds' rectangles missing.
+    int64_t seedCount = (int64_t)worldSeeds.size();
+    std::vector<std::vector<Rectangle>> localResults(seedCount);
+    std::vector<int64_t> seedDimensions(seedCount);
+    std::vector<int64_t> seedAreas(seedCount);
+    std::vector<int64_t> pendingUnits;
+    bindStageCounters(engines.metrics != nullptr ? &engines.metrics->forThread(threadId) : nullptr);
+    
+    // One arena per seed, since every seed's grid is live at once during the shared pass
+    int64_t arenaSide = paddedUnitSide(workQueue.unitSize(), minimumRectDimension);
+    std::vector<std::unique_ptr<UnitArena>> arenas;
+    for (int64_t k = 0; k < seedCount; k++) {
+        arenas.push_back(std::make_unique<UnitArena>(arenaSide, arenaSide, engines.simdLevel));
+    }
+    
+    while (!pauseFlag) {
+        WorkUnit work;
+        if (!workQueue.next(work, threadId)) {
+            break;
+        }
+        if (progress.isDone(work.index)) {
+            continue;
+        }
+        
+        // Largest mode tracks each seed's own best. The padding follows the smallest of
+        // them, since it has to cover every seed's boundary rectangles.
+        int64_t unitDimension = 0;
+        for (int64_t k = 0; k < seedCount; k++) {
+            seedDimensions[k] = minimumRectDimension;
+            if (engines.searchMode == SearchMode::Largest) {
+                seedDimensions[k] = std::max(seedDimensions[k], results[k]->bestShortSide());
+                for (const Rectangle& rect : localResults[k]) {
+                    seedDimensions[k] = std::max(seedDimensions[k], std::min(rect.width, rect.height));
+                }
+            }
+            seedAreas[k] = results[k]->admissionArea();
+            unitDimension = (k == 0) ? seedDimensions[k] : std::min(unitDimension, seedDimensions[k]);
+        }
+        
+        processRegionMultiSeed(work.minX, work.maxX, work.minZ, work.maxZ, worldSeeds, unitDimension,
+                               seedDimensions, seedAreas, searchMinX, searchMaxX, searchMinZ, searchMaxZ,
+                               localResults, chunksProcessed, engines, debugMode, &arenas);
+        pendingUnits.push_back(work.index);
+        
+        // insertBatch empties a merged buffer and accepts an empty one, so a seed merged
+        // at an earlier unit doesn't hold the others back
+        bool allMerged = true;
+        for (int64_t k = 0; k < seedCount; k++) {
+            bool blocking = (int64_t)localResults[k].size() >= RESULT_BUFFER_FLUSH_SIZE;
+            allMerged = results[k]->insertBatch(localResults[k], blocking) && allMerged;
+        }
+        if (allMerged) {
+            for (int64_t unit : pendingUnits) {
+                progress.markDone(unit);
+            }
+            pendingUnits.clear();
+        }
+        
+        int64_t centerX = (work.minX + work.maxX) / 2;
+        int64_t centerZ = (work.minZ + work.maxZ) / 2;
+        int64_t dist = (int64_t)std::sqrt(centerX * centerX + centerZ * centerZ);
+        
+        int64_t currentMax = maxDistanceReached.load(std::memory_order_relaxed);
+        while (dist > currentMax && 
+               !maxDistanceReached.compare_exchange_weak(currentMax, dist, std::memory_order_relaxed)) {
+        }
+    }
+    
+    for (int64_t k = 0; k < seedCount; k++) {
+        results[k]->insertBatch(localResults[k], true);
+    }
+    for (int64_t unit : pendingUnits) {
+        progress.markDone(unit);
+    }
+    bindStageCounters(nullptr);
+}
+
+// SEED SWEEP
+bool SeedRectangle::operator<(const SeedRectangle& other) const {
+    if (rect < other.rect) return true;
+    if (other.rect < rect) return false;
+    return worldSeed < other.worldSeed;
+}
+
+SeedResultStore::SeedResultStore(int64_t capacity) : maxEntries(capacity) {
+}
+
+void SeedResultStore::insertBatch(std::vector<SeedRectangle>& batch) {
+    if (batch.empty()) return;
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.insert(batch.begin(), batch.end());
+    if (maxEntries > 0 && (int64_t)entries.size() >= maxEntries) {
+        while ((int64_t)entries.size() > maxEntries) {
+            entries.erase(std::prev(entries.end()));
+        }
+        admissionThreshold.store(std::prev(entries.end())->rect.area, std::memory_order_relaxed);
+    }
+    count.store((int64_t)entries.size(), std::memory_order_relaxed);
+    batch.clear();
+}
+
+std::vector<SeedRectangle> SeedResultStore::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::vector<SeedRectangle>(entries.begin(), entries.end());
+}
+
+SeedSweepQueue::SeedSweepQueue(int64_t start, int64_t end, int64_t completedBlocks)
+    : seedStart(start), seedEnd(std::max(start, end)) {
+    blocks = (seedEnd - seedStart + SEED_SWEEP_BLOCK_SIZE - 1) / SEED_SWEEP_BLOCK_SIZE;
+    watermark = std::min(std::max(completedBlocks, (int64_t)0), blocks);
+    cursor.store(watermark);
+}
+
+bool SeedSweepQueue::next(int64_t& block) {
+    int64_t claimed = cursor.fetch_add(1, std::memory_order_relaxed);
+    if (claimed >= blocks) {
+        return false;
+    }
+    block = claimed;
+    return true;
+}
+
+void SeedSweepQueue::markDone(int64_t block) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (block != watermark) {
+        doneAhead.insert(block);
+        return;
+    }
+    watermark++;
+    while (!doneAhead.empty() && *doneAhead.begin() == watermark) {
+        doneAhead.erase(doneAhead.begin());
+        watermark++;
+    }
+}
+
+int64_t SeedSweepQueue::completedBlocks() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return watermark;
+}
+
+int64_t SeedSweepQueue::seedCount(int64_t block) const {
+    return std::min(SEED_SWEEP_BLOCK_SIZE, seedEnd - firstSeed(block));
+}
+
+int64_t seedSweepPassSeeds(int64_t width, int64_t height) {
+    int64_t gridBytes = std::max<int64_t>(height * gridRowStride(width) * (int64_t)sizeof(uint64_t), 1);
+    return std::min(SEED_SWEEP_BLOCK_SIZE, SEED_SWEEP_GRID_BUDGET / gridBytes);
+}
+
+void processSeedBlock(int64_t firstSeed, int64_t seedCount,
+                      int64_t minX, int64_t maxX, int64_t minZ, int64_t maxZ,
+                      int64_t minimumRectDimension, int64_t minimumArea,
+                      std::vector<SlimeGrid>& grids,
+                      std::vector<SeedRectangle>& results,
+                      const EngineConfig& engines) {
+    int64_t width = maxX - minX;
+    int64_t height = maxZ - minZ;
+    if (width < minimumRectDimension || height < minimumRectDimension || seedCount <= 0) {
+        return;
+    }
+    
+    // The polynomial of each chunk is computed once per pass; each seed only pays for its
+    // add/XOR/LCG tail. A large region takes several passes, as its grids don't all fit.
+    // Every grid has the same shape and admission area, so one scanner serves the block,
+    // and the best rectangle of a seed is always maximal.
+    int64_t passSeeds = std::min((int64_t)grids.size(), seedCount);
+    int64_t seeds[SEED_SWEEP_BLOCK_SIZE];
+    uint64_t* rowBits[SEED_SWEEP_BLOCK_SIZE];
+    const SlimeKernel& kernel = slimeKernelFor(engines.simdLevel);
+    std::vector<Rectangle> found;
+    std::vector<std::pair<int64_t, int64_t>> bands;
+    for (int64_t first = 0; first < seedCount; first += passSeeds) {
+        int64_t count = std::min(passSeeds, seedCount - first);
+        for (int64_t k = 0; k < count; k++) {
+            seeds[k] = firstSeed + first + k;
+            grids[k].resize(height, width);
+        }
+        for (int64_t z = 0; z < height; z++) {
+            for (int64_t k = 0; k < count; k++) {
+                rowBits[k] = grids[k].row(z);
+            }
+            kernel.fillRowMultiSeed(minX, minZ + z, width, seeds, count, rowBits);
+        }
+        
+        int64_t scanDimension = gridScanDimension(grids[0], minimumRectDimension, minimumArea);
+        RectangleScanner scanner(width, minX, minZ, scanDimension, RectMode::Maximal, minimumArea,
+                                 false, engines.simdLevel);
+        for (int64_t k = 0; k < count; k++) {
+            found.clear();
+            if (engines.rectFilter == RectFilter::SquareAnd) {
+                scanSquareBands(grids[k], scanDimension, scanner, found, bands);
+            } else {
+                scanner.begin(0);
+                for (int64_t z = 0; z < height; z++) {
+                    scanner.pushRow(grids[k].row(z), found);
+                }
+                scanner.finish(found);
+            }
+            if (!found.empty()) {
+                results.push_back({seeds[k], *std::min_element(found.begin(), found.end())});
+            }
+        }
+    }
+}
+
+void seedSweepThread(int64_t threadId,
+                     int64_t minX, int64_t maxX, int64_t minZ, int64_t maxZ,
+                     int64_t minimumRectDimension,
+                     SeedSweepQueue& queue,
+                     SeedResultStore& results,
+                     std::atomic<bool>& pauseFlag,
+                     std::atomic<int64_t>& seedsProcessed,
+                     const EngineConfig& engines) {
+    pinWorker(engines, threadId);
+    
+    std::vector<SlimeGrid> grids(std::max<int64_t>(seedSweepPassSeeds(maxX - minX, maxZ - minZ), 1));
+    std::vector<SeedRectangle> batch;
+    int64_t block;
+    while (!pauseFlag && queue.next(block)) {
+        processSeedBlock(queue.firstSeed(block), queue.seedCount(block), minX, maxX, minZ, maxZ,
+                         minimumRectDimension, results.admissionArea(), grids, batch, engines);
+        results.insertBatch(batch);
+        queue.markDone(block);
+        seedsProcessed += queue.seedCount(block);
+    }
+}
+
+void printStats(const std::atomic<int64_t>& chunksProcessed,
+                const std::atomic<int64_t>& maxDistanceReached,
+                const RectangleStore& results,
+                bool toFile,
+                const std::string& fileName) {
+    printStats(chunksProcessed, maxDistanceReached, results.snapshot(), results.capacity(), results.admissionArea(),
+               toFile, fileName);
 }
 
 void printStats(const std::atomic<int64_t>& chunksProcessed,
                 const std::atomic<int64_t>& maxDistanceReached,
-                const std::set<Rectangle>& foundRectangles,
-                bool toFile) {
+                const std::vector<Rectangle>& foundRectangles,
+                int64_t capacity,
+                int64_t admissionArea,
+                bool toFile,
+                const std::string& fileName) {
     std::ostream* out = &std::cout;
     std::ofstream fileOut;
     
     if (toFile) {
-        fileOut.open("slimechunkfinder.txt", std::ios::out | std::ios::trunc);
+        fileOut.open(fileName, std::ios::out | std::ios::trunc);
         if (fileOut.is_open()) {
             out = &fileOut;
         }
@@ -435,7 +3688,11 @@ void printStats(const std::atomic<int64_t>& chunksProcessed,
     *out << "========================================\n";
     *out << "Chunks processed: " << chunksProcessed.load() << "\n";
     *out << "Max distance: " << maxDistanceReached.load() << " chunks\n";
-    *out << "Rectangles found: " << foundRectangles.size() << "\n\n";
+    *out << "Rectangles found: " << foundRectangles.size();
+    if (capacity > 0) {
+        *out << " (keeping best " << capacity << ", admission area " << admissionArea << ")";
+    }
+    *out << "\n\n";
     
     if (!foundRectangles.empty()) {
         *out << "All rectangles (sorted by size, then distance from spawn):\n";
@@ -476,3 +3733,53 @@ void printStats(const std::atomic<int64_t>& chunksProcessed,
         fileOut.close();
     }
 }
+
+void printSeedSweepStats(int64_t seedsProcessed,
+                         const SeedResultStore& results,
+                         bool toFile,
+                         const std::string& fileName) {
+    std::ostream* out = &std::cout;
+    std::ofstream fileOut;
+    std::vector<SeedRectangle> foundSeeds = results.snapshot();
+    
+    if (toFile) {
+        fileOut.open(fileName, std::ios::out | std::ios::trunc);
+        if (fileOut.is_open()) {
+            out = &fileOut;
+        }
+    }
+    
+    *out << "\n========================================\n";
+    *out << "SEED SWEEP STATISTICS\n";
+    *out << "========================================\n";
+    *out << "Seeds processed: " << seedsProcessed << "\n";
+    *out << "Seeds kept: " << foundSeeds.size();
+    if (results.capacity() > 0) {
+        *out << " (best " << results.capacity() << ", admission area " << results.admissionArea() << ")";
+    }
+    *out << "\n\n";
+    
+    if (!foundSeeds.empty()) {
+        *out << "Best rectangle of each seed (sorted by size, then distance from spawn):\n";
+        *out << std::setw(18) << "Seed"
+             << std::setw(12) << "Area"
+             << std::setw(10) << "Width"
+             << std::setw(10) << "Height"
+             << std::setw(12) << "Block X"
+             << std::setw(12) << "Block Z"
+             << std::setw(14) << "Euclidean" << "\n";
+        *out << std::string(88, '-') << "\n";
+        
+        for (const auto& entry : foundSeeds) {
+            const Rectangle& rect = entry.rect;
+            *out << std::setw(18) << entry.worldSeed
+                 << std::setw(12) << rect.area
+                 << std::setw(10) << rect.width
+                 << std::setw(10) << rect.height
+                 << std::setw(12) << (rect.x * 16)
+                 << std::setw(12) << (rect.z * 16)
+                 << std::setw(14) << (int64_t)std::sqrt(rect.distanceSquared) << "\n";
+        }
+    }
+    *out << "========================================\n\n";
+}
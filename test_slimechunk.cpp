@@ -2,6 +2,10 @@
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <filesystem>
+#include <thread>
 
 // ==================== UNIT TESTS ====================
 
@@ -36,11 +40,16 @@ bool testOptimizations() {
                   << (result ? "SLIME" : "NOT") << "\n";
     }
 
+    if (detectSimdLevel() < SimdLevel::AVX512) {
+        std::cout << "\nAVX-512 not supported on this CPU, skipping 16-way batch check\n";
+        std::cout << "========================================\n\n";
+        return true;
+    }
+
     // Test vectorized batch processing (16-way)
     std::cout << "\nTesting AVX-512 16-way batch processing:\n";
     alignas(64) int64_t batchX[16];
     alignas(64) int64_t batchZ[16];
-    alignas(64) bool batchResults[16];
 
     // Fill batch arrays from test_coords (9 test coords, pad rest with zeros)
     int numTests = sizeof(test_coords) / sizeof(test_coords[0]);
@@ -54,14 +63,15 @@ bool testOptimizations() {
         }
     }
 
-    isSlimeChunkVec16(batchX, batchZ, TEST_WORLD_SEED, batchResults);
+    __mmask16 batchMask = isSlimeChunkVec16(batchX, batchZ, TEST_WORLD_SEED);
 
     for (int i = 0; i < numTests; i++) {
         bool scalarResult = isSlimeChunk(batchX[i], batchZ[i], TEST_WORLD_SEED);
-        bool matches = (scalarResult == batchResults[i]);
+        bool vectorResult = (batchMask >> i) & 1;
+        bool matches = (scalarResult == vectorResult);
 
         std::cout << "  Chunk (" << batchX[i] << ", " << batchZ[i] << "): "
-                  << "Scalar=" << scalarResult << " Vector=" << batchResults[i]
+                  << "Scalar=" << scalarResult << " Vector=" << vectorResult
                   << " " << (matches ? "[MATCH]" : "[MISMATCH]") << "\n";
 
         if (!matches) {
@@ -80,12 +90,1685 @@ bool testOptimizations() {
     return allMatch;
 }
 
-bool runUnitTests() {
+bool testVectorKernelSweep() {
+    std::cout << "Testing vector kernels against scalar reference...\n";
+    std::cout << "========================================\n";
+
+    const int64_t seeds[] = {413563856LL, 0LL, -1LL, 0x7FFFFFFFFFFFLL, -8532914071648413962LL};
+
+    // Dense sweeps around the origin, the test rectangle, the world border
+    // and the int32 wraparound edges
+    const int64_t origins[][2] = {
+        {0, 0},
+        {1480, 8270},
+        {-1875000, 1874900},
+        {INT32_MAX - 100, INT32_MIN + 100},
+        {INT32_MAX / 16 - 50, -(INT32_MAX / 16) - 50},
+        {(int64_t)1 << 33, -((int64_t)1 << 35)},
+    };
+
+    alignas(64) int64_t batchX[16];
+    alignas(64) int64_t batchZ[16];
+    int64_t checked = 0;
+    int64_t mismatches = 0;
+
+    // Every vector width the CPU supports sees the same batches
+    const SimdLevel simdLevel = detectSimdLevel();
+    std::cout << "  Widest supported level: " << simdLevelName(simdLevel) << "\n";
+
+    auto compareMask = [&](int64_t worldSeed, uint32_t mask, const char* kernel) {
+        for (int i = 0; i < 16; i++) {
+            bool expected = isSlimeChunk(batchX[i], batchZ[i], worldSeed);
+            bool actual = (mask >> i) & 1;
+            checked++;
+            if (expected != actual) {
+                if (mismatches < 10) {
+                    std::cout << "  MISMATCH " << kernel << " seed=" << worldSeed << " chunk (" << batchX[i] << ", "
+                              << batchZ[i] << "): scalar=" << expected << " vector=" << actual << "\n";
+                }
+                mismatches++;
+            }
+        }
+    };
+
+    auto checkBatch = [&](int64_t worldSeed) {
+        if (simdLevel >= SimdLevel::AVX512) {
+            compareMask(worldSeed, isSlimeChunkVec16(batchX, batchZ, worldSeed), "avx512");
+        }
+        if (simdLevel >= SimdLevel::AVX2) {
+            uint32_t mask = isSlimeChunkVec8(batchX, batchZ, worldSeed) |
+                            ((uint32_t)isSlimeChunkVec8(batchX + 8, batchZ + 8, worldSeed) << 8);
+            compareMask(worldSeed, mask, "avx2");
+        }
+    };
+
+    for (int64_t worldSeed : seeds) {
+        for (const auto& origin : origins) {
+            for (int64_t z = 0; z < 64; z++) {
+                for (int64_t x = 0; x < 256; x += 16) {
+                    for (int i = 0; i < 16; i++) {
+                        batchX[i] = origin[0] + x + i;
+                        batchZ[i] = origin[1] + z;
+                    }
+                    checkBatch(worldSeed);
+                }
+            }
+        }
+
+        // Scattered coordinates across the full int64 input range
+        uint64_t state = 0x9E3779B97F4A7C15ULL ^ (uint64_t)worldSeed;
+        for (int batch = 0; batch < 4096; batch++) {
+            for (int i = 0; i < 16; i++) {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                batchX[i] = (int64_t)state;
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                batchZ[i] = (int64_t)state >> (state & 31);
+            }
+            checkBatch(worldSeed);
+        }
+    }
+
+    std::cout << "  Checked " << checked << " chunks, " << mismatches << " mismatches\n";
+    if (mismatches == 0) {
+        std::cout << "\n[PASS] Vector kernels are bit-exact with isSlimeChunk\n";
+    } else {
+        std::cout << "\n[FAIL] Vector kernels disagree with isSlimeChunk\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return mismatches == 0;
+}
+
+bool testRowKernel() {
+    std::cout << "Testing row fills of every supported kernel against scalar reference...\n";
+    std::cout << "========================================\n";
+
+    const int64_t seeds[] = {413563856LL, -1LL, 0x7FFFFFFFFFFFLL};
+
+    // Row starts chosen so the finite differences cross zero and the int32 wraparound
+    const int64_t rowStarts[][2] = {
+        {-600, 0},
+        {1200, 8282},
+        {-1875000, -1874999},
+        {INT32_MAX - 700, INT32_MIN + 5},
+        {-(INT32_MAX / 16) - 300, INT32_MAX / 16},
+        {(int64_t)1 << 34, -((int64_t)1 << 33) - 1},
+    };
+    // Lengths cover partial batches and partial words
+    const int64_t lengths[] = {1, 15, 16, 17, 63, 64, 65, 1028};
+
+    std::vector<uint64_t> rowBits((1028 + 63) / 64);
+    int64_t checked = 0;
+    int64_t mismatches = 0;
+
+    // Batch and row fills of every kernel level the CPU supports
+    struct RowFill {
+        std::string name;
+        void (*fill)(int64_t, int64_t, int64_t, int64_t, uint64_t*);
+    };
+    std::vector<RowFill> fills;
+    for (int level = 0; level <= (int)detectSimdLevel(); level++) {
+        const SlimeKernel& kernel = slimeKernelFor((SimdLevel)level);
+        fills.push_back({std::string(simdLevelName(kernel.level)) + " batch", kernel.fillRowBatch});
+        fills.push_back({std::string(simdLevelName(kernel.level)) + " row", kernel.fillRowIncremental});
+
+        // The startup self-check must accept every kernel that passes this sweep
+        if (!verifySlimeKernel(kernel, seeds[0])) {
+            std::cout << "  verifySlimeKernel rejected " << kernel.name << "\n";
+            mismatches++;
+        }
+    }
+
+    for (const RowFill& rowFill : fills) {
+        for (int64_t worldSeed : seeds) {
+            for (const auto& start : rowStarts) {
+                for (int64_t count : lengths) {
+                    for (int64_t dz = 0; dz < 8; dz++) {
+                        std::fill(rowBits.begin(), rowBits.end(), ~0ULL);
+                        rowFill.fill(start[0], start[1] + dz, count, worldSeed, rowBits.data());
+
+                        // Lanes past count within the last word must come back cleared
+                        int64_t paddedCount = (count + 63) & ~63LL;
+                        for (int64_t x = 0; x < paddedCount; x++) {
+                            bool actual = (rowBits[x >> 6] >> (x & 63)) & 1;
+                            bool expected = (x < count) && isSlimeChunk(start[0] + x, start[1] + dz, worldSeed);
+                            checked++;
+                            if (expected != actual) {
+                                if (mismatches < 10) {
+                                    std::cout << "  MISMATCH " << rowFill.name
+                                              << " seed=" << worldSeed << " chunk (" << (start[0] + x)
+                                              << ", " << (start[1] + dz) << ") count=" << count
+                                              << ": scalar=" << expected << " kernel=" << actual << "\n";
+                                }
+                                mismatches++;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Multi-seed fills write every seed's row in one call
+    const int64_t seedCount = sizeof(seeds) / sizeof(seeds[0]);
+    std::vector<std::vector<uint64_t>> seedRows(seedCount, std::vector<uint64_t>(rowBits.size()));
+    std::vector<uint64_t*> seedRowPointers;
+    for (auto& seedRow : seedRows) {
+        seedRowPointers.push_back(seedRow.data());
+    }
+    for (int level = 0; level <= (int)detectSimdLevel(); level++) {
+        const SlimeKernel& kernel = slimeKernelFor((SimdLevel)level);
+        for (const auto& start : rowStarts) {
+            for (int64_t count : lengths) {
+                for (auto& seedRow : seedRows) {
+                    std::fill(seedRow.begin(), seedRow.end(), ~0ULL);
+                }
+                kernel.fillRowMultiSeed(start[0], start[1], count, seeds, seedCount, seedRowPointers.data());
+                int64_t paddedCount = (count + 63) & ~63LL;
+                for (int64_t k = 0; k < seedCount; k++) {
+                    for (int64_t x = 0; x < paddedCount; x++) {
+                        bool actual = (seedRows[k][x >> 6] >> (x & 63)) & 1;
+                        bool expected = (x < count) && isSlimeChunk(start[0] + x, start[1], seeds[k]);
+                        checked++;
+                        if (expected != actual) {
+                            if (mismatches < 10) {
+                                std::cout << "  MISMATCH " << simdLevelName(kernel.level) << " multi-seed"
+                                          << " seed=" << seeds[k] << " chunk (" << (start[0] + x)
+                                          << ", " << start[1] << ") count=" << count
+                                          << ": scalar=" << expected << " kernel=" << actual << "\n";
+                            }
+                            mismatches++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    std::cout << "  Checked " << checked << " chunks, " << mismatches << " mismatches\n";
+    if (mismatches == 0) {
+        std::cout << "\n[PASS] Row fills are bit-exact with isSlimeChunk\n";
+    } else {
+        std::cout << "\n[FAIL] Row fills disagree with isSlimeChunk\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return mismatches == 0;
+}
+
+// Random grid with the given fill probability (per mille) plus a few planted solid blocks
+static void fillSyntheticGrid(SlimeGrid& grid, uint64_t seed, int64_t densityPerMille, int64_t plantedBlocks, int64_t maxBlockSide) {
+    uint64_t state = seed;
+    auto next = [&state]() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state >> 33;
+    };
+
+    for (int64_t r = 0; r < grid.rows; r++) {
+        for (int64_t c = 0; c < grid.cols; c++) {
+            if ((int64_t)(next() % 1000) < densityPerMille) {
+                grid.set(r, c);
+            }
+        }
+    }
+    for (int64_t b = 0; b < plantedBlocks; b++) {
+        int64_t h = 1 + next() % maxBlockSide;
+        int64_t w = 1 + next() % maxBlockSide;
+        int64_t r0 = next() % grid.rows;
+        int64_t c0 = next() % grid.cols;
+        for (int64_t r = r0; r < std::min(grid.rows, r0 + h); r++) {
+            for (int64_t c = c0; c < std::min(grid.cols, c0 + w); c++) {
+                grid.set(r, c);
+            }
+        }
+    }
+}
+
+bool testHeightKernels() {
+    std::cout << "Testing histogram height kernels against scalar reference...\n";
+    std::cout << "========================================\n";
+
+    // Odd widths leave partial vectors; full density keeps whole words set for many rows
+    struct Case { int64_t rows, cols, density; };
+    const Case cases[] = {
+        {40, 77, 500},
+        {300, 1000, 990},
+        {20, 1028, 1000},
+        {64, 33, 100},
+    };
+    const uint16_t thresholds[] = {1, 2, 5, 300};
+
+    int64_t mismatches = 0;
+    uint64_t seed = 2000;
+    for (int level = 0; level <= (int)detectSimdLevel(); level++) {
+        const SlimeKernel& kernel = slimeKernelFor((SimdLevel)level);
+        for (const Case& tc : cases) {
+            for (uint16_t threshold : thresholds) {
+                SlimeGrid grid(tc.rows, tc.cols);
+                fillSyntheticGrid(grid, seed++, tc.density, 0, 1);
+
+                std::vector<uint16_t> heights((tc.cols + 31) / 32 * 32, 0);
+                std::vector<int64_t> expected(tc.cols, 0);
+                for (int64_t r = 0; r < tc.rows; r++) {
+                    bool tall = kernel.updateHeights(heights.data(), grid.row(r), tc.cols, threshold);
+
+                    bool expectedTall = false;
+                    bool same = true;
+                    for (int64_t c = 0; c < tc.cols; c++) {
+                        expected[c] = grid.get(r, c) ? expected[c] + 1 : 0;
+                        expectedTall = expectedTall || expected[c] >= threshold;
+                        same = same && heights[c] == expected[c];
+                    }
+                    if (!same || tall != expectedTall) {
+                        if (mismatches < 10) {
+                            std::cout << "  MISMATCH " << kernel.name << " " << tc.rows << "x" << tc.cols
+                                      << " threshold=" << threshold << " row=" << r << "\n";
+                        }
+                        mismatches++;
+                    }
+                }
+            }
+        }
+    }
+
+    if (mismatches == 0) {
+        std::cout << "[PASS] Height kernels match the scalar reference\n";
+    } else {
+        std::cout << "[FAIL] Height kernels disagree with the scalar reference\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return mismatches == 0;
+}
+
+bool testSquareFilter() {
+    std::cout << "Testing AND-of-rows square filter against full histogram scan...\n";
+    std::cout << "========================================\n";
+
+    struct Case { int64_t rows, cols, density, blocks, maxSide, n; };
+    const Case cases[] = {
+        {60, 60, 500, 4, 8, 2},
+        {200, 130, 300, 12, 12, 3},
+        {257, 200, 100, 20, 30, 5},
+        {300, 300, 50, 8, 90, 64},
+        {300, 300, 50, 8, 90, 70},
+        {150, 700, 20, 30, 140, 129},
+    };
+
+    bool allMatch = true;
+    uint64_t seed = 1;
+    for (const Case& tc : cases) {
+        for (int rep = 0; rep < 4; rep++) {
+            SlimeGrid grid(tc.rows, tc.cols);
+            fillSyntheticGrid(grid, seed++, tc.density, tc.blocks, tc.maxSide);
+
+            for (RectMode mode : {RectMode::Exhaustive, RectMode::Maximal}) {
+                std::vector<Rectangle> fullResults;
+                std::vector<Rectangle> filteredResults;
+                findMaximalRectangles(grid, 0, grid.rows, 0, 0, tc.n, fullResults, mode);
+
+                std::vector<std::pair<int64_t, int64_t>> bands;
+                bool anyBand = findSquareCandidateBands(grid, tc.n, bands);
+                for (const auto& band : bands) {
+                    findMaximalRectangles(grid, band.first, band.second, 0, 0, tc.n, filteredResults, mode);
+                }
+                std::set<Rectangle> fullScan(fullResults.begin(), fullResults.end());
+                std::set<Rectangle> filtered(filteredResults.begin(), filteredResults.end());
+
+                bool matches = (fullScan.size() == filtered.size()) &&
+                               std::equal(fullScan.begin(), fullScan.end(), filtered.begin(),
+                                          [](const Rectangle& a, const Rectangle& b) {
+                                              return a.x == b.x && a.z == b.z && a.width == b.width && a.height == b.height;
+                                          });
+                if (anyBand != !fullScan.empty()) {
+                    matches = false;
+                }
+                if (!matches) {
+                    std::cout << "  MISMATCH " << tc.rows << "x" << tc.cols << " n=" << tc.n << " rep=" << rep
+                              << " mode=" << rectModeName(mode)
+                              << ": full=" << fullScan.size() << " filtered=" << filtered.size() << "\n";
+                    allMatch = false;
+                }
+            }
+        }
+    }
+
+    if (allMatch) {
+        std::cout << "[PASS] Square filter reports the same rectangles as the full scan\n";
+    } else {
+        std::cout << "[FAIL] Square filter changed the reported rectangles\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return allMatch;
+}
+
+// Brute-force oracle: every all-slime rectangle of at least n x n that cannot be grown
+// by a row or column in any direction without leaving the grid or hitting a non-slime chunk
+static std::set<std::pair<std::pair<int64_t, int64_t>, std::pair<int64_t, int64_t>>>
+bruteForceMaximalRectangles(const SlimeGrid& grid, int64_t n) {
+    int64_t rows = grid.rows;
+    int64_t cols = grid.cols;
+
+    // Prefix sums for O(1) all-slime checks
+    std::vector<int64_t> prefix((rows + 1) * (cols + 1), 0);
+    for (int64_t r = 0; r < rows; r++) {
+        for (int64_t c = 0; c < cols; c++) {
+            prefix[(r + 1) * (cols + 1) + c + 1] = grid.get(r, c) + prefix[r * (cols + 1) + c + 1] +
+                                                    prefix[(r + 1) * (cols + 1) + c] - prefix[r * (cols + 1) + c];
+        }
+    }
+    auto allSlime = [&](int64_t r0, int64_t c0, int64_t r1, int64_t c1) {
+        if (r0 < 0 || c0 < 0 || r1 >= rows || c1 >= cols) return false;
+        int64_t sum = prefix[(r1 + 1) * (cols + 1) + c1 + 1] - prefix[r0 * (cols + 1) + c1 + 1] -
+                      prefix[(r1 + 1) * (cols + 1) + c0] + prefix[r0 * (cols + 1) + c0];
+        return sum == (r1 - r0 + 1) * (c1 - c0 + 1);
+    };
+
+    std::set<std::pair<std::pair<int64_t, int64_t>, std::pair<int64_t, int64_t>>> result;
+    for (int64_t r0 = 0; r0 < rows; r0++) {
+        for (int64_t c0 = 0; c0 < cols; c0++) {
+            for (int64_t r1 = r0 + n - 1; r1 < rows; r1++) {
+                for (int64_t c1 = c0 + n - 1; c1 < cols; c1++) {
+                    if (!allSlime(r0, c0, r1, c1)) break;
+                    if (allSlime(r0 - 1, c0, r1, c1) || allSlime(r0, c0, r1 + 1, c1) ||
+                        allSlime(r0, c0 - 1, r1, c1) || allSlime(r0, c0, r1, c1 + 1)) {
+                        continue;
+                    }
+                    result.insert({{c0, r0}, {c1 - c0 + 1, r1 - r0 + 1}});
+                }
+            }
+        }
+    }
+    return result;
+}
+
+bool testMaximalRectangles() {
+    std::cout << "Testing maximal rectangle mode against brute-force oracle...\n";
+    std::cout << "========================================\n";
+
+    struct Case { int64_t rows, cols, density, blocks, maxSide, n; };
+    const Case cases[] = {
+        {12, 20, 700, 0, 1, 1},
+        {30, 40, 600, 3, 6, 2},
+        {40, 70, 400, 6, 12, 3},
+        {33, 130, 300, 8, 20, 4},
+    };
+
+    bool allMatch = true;
+    uint64_t seed = 1000;
+    for (const Case& tc : cases) {
+        for (int rep = 0; rep < 8; rep++) {
+            SlimeGrid grid(tc.rows, tc.cols);
+            fillSyntheticGrid(grid, seed++, tc.density, tc.blocks, tc.maxSide);
+
+            // Every supported height kernel, each skipping rows that are too short
+            SimdLevel simdLevel = (SimdLevel)(rep % ((int)detectSimdLevel() + 1));
+            std::vector<Rectangle> found;
+            findMaximalRectangles(grid, 0, grid.rows, 0, 0, tc.n, found, RectMode::Maximal, 0, false, simdLevel);
+
+            std::set<std::pair<std::pair<int64_t, int64_t>, std::pair<int64_t, int64_t>>> actual;
+            for (const auto& rect : found) {
+                actual.insert({{rect.x, rect.z}, {rect.width, rect.height}});
+            }
+            auto expected = bruteForceMaximalRectangles(grid, tc.n);
+
+            if (actual != expected || actual.size() != found.size()) {
+                std::cout << "  MISMATCH " << tc.rows << "x" << tc.cols << " n=" << tc.n << " rep=" << rep
+                          << ": found=" << found.size() << " expected=" << expected.size() << "\n";
+                allMatch = false;
+            }
+        }
+    }
+
+    if (allMatch) {
+        std::cout << "[PASS] Maximal mode matches the brute-force oracle\n";
+    } else {
+        std::cout << "[FAIL] Maximal mode disagrees with the brute-force oracle\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return allMatch;
+}
+
+bool testExhaustiveRectangles() {
+    std::cout << "Testing exhaustive rectangle mode against brute force...\n";
+    std::cout << "========================================\n";
+
+    // Dense grids, where extensions run long after the minimum height is lost
+    struct Case { int64_t rows, cols, density, n, minArea; };
+    const Case cases[] = {
+        {20, 70, 950, 3, 0},
+        {30, 130, 990, 5, 0},
+        {25, 90, 800, 2, 12},
+        {16, 64, 1000, 4, 0},
+    };
+
+    bool allMatch = true;
+    uint64_t seed = 3000;
+    for (const Case& tc : cases) {
+        SlimeGrid grid(tc.rows, tc.cols);
+        fillSyntheticGrid(grid, seed++, tc.density, 0, 1);
+
+        // Every (row, first column, last column) with the tallest all-slime rectangle above it
+        std::set<std::pair<std::pair<int64_t, int64_t>, std::pair<int64_t, int64_t>>> expected;
+        for (int64_t r = 0; r < tc.rows; r++) {
+            for (int64_t i = 0; i < tc.cols; i++) {
+                for (int64_t j = i; j < tc.cols; j++) {
+                    int64_t minHeight = INT64_MAX;
+                    for (int64_t c = i; c <= j; c++) {
+                        int64_t h = 0;
+                        while (r - h >= 0 && grid.get(r - h, c)) h++;
+                        minHeight = std::min(minHeight, h);
+                    }
+                    int64_t width = j - i + 1;
+                    if (width >= tc.n && minHeight >= tc.n && width * minHeight >= tc.minArea) {
+                        expected.insert({{i, r - minHeight + 1}, {width, minHeight}});
+                    }
+                }
+            }
+        }
+
+        for (int level = 0; level <= (int)detectSimdLevel(); level++) {
+            std::vector<Rectangle> found;
+            findMaximalRectangles(grid, 0, grid.rows, 0, 0, tc.n, found, RectMode::Exhaustive, tc.minArea,
+                                  false, (SimdLevel)level);
+            std::set<std::pair<std::pair<int64_t, int64_t>, std::pair<int64_t, int64_t>>> actual;
+            for (const auto& rect : found) {
+                actual.insert({{rect.x, rect.z}, {rect.width, rect.height}});
+            }
+            if (actual != expected || actual.size() != found.size()) {
+                std::cout << "  MISMATCH " << tc.rows << "x" << tc.cols << " n=" << tc.n
+                          << " simd=" << simdLevelName((SimdLevel)level)
+                          << ": found=" << found.size() << " expected=" << expected.size() << "\n";
+                allMatch = false;
+            }
+        }
+    }
+
+    if (allMatch) {
+        std::cout << "[PASS] Exhaustive mode matches brute force\n";
+    } else {
+        std::cout << "[FAIL] Exhaustive mode disagrees with brute force\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return allMatch;
+}
+
+bool testTopKStore() {
+    std::cout << "Testing bounded top-K result store...\n";
+    std::cout << "========================================\n";
+
+    const int64_t capacity = 50;
+    RectangleStore bounded(capacity);
+    std::set<Rectangle> reference;
+
+    uint64_t state = 77;
+    auto next = [&state]() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (int64_t)(state >> 33);
+    };
+
+    bool passed = true;
+    for (int batchIndex = 0; batchIndex < 40; batchIndex++) {
+        std::vector<Rectangle> batch;
+        for (int i = 0; i < 25; i++) {
+            int64_t w = 1 + next() % 12;
+            int64_t h = 1 + next() % 12;
+            Rectangle rect;
+            rect.x = next() % 2000 - 1000;
+            rect.z = next() % 2000 - 1000;
+            rect.width = w;
+            rect.height = h;
+            rect.area = w * h;
+            int64_t cx = (rect.x + w / 2) * 16;
+            int64_t cz = (rect.z + h / 2) * 16;
+            rect.distanceSquared = cx * cx + cz * cz;
+            batch.push_back(rect);
+            reference.insert(rect);
+        }
+        // Duplicates across batches must not take extra slots
+        std::vector<Rectangle> repeat = batch;
+        bounded.insertBatch(batch, true);
+        bounded.insertBatch(repeat, true);
+
+        int64_t expectedThreshold = ((int64_t)reference.size() >= capacity)
+                                        ? std::next(reference.begin(), capacity - 1)->area : 0;
+        if (bounded.admissionArea() != expectedThreshold) {
+            std::cout << "  Threshold after batch " << batchIndex << ": " << bounded.admissionArea()
+                      << " expected " << expectedThreshold << "\n";
+            passed = false;
+        }
+    }
+
+    std::vector<Rectangle> kept = bounded.snapshot();
+    std::vector<Rectangle> expected(reference.begin(), std::next(reference.begin(), capacity));
+    bool sameEntries = kept.size() == expected.size() &&
+                       std::equal(kept.begin(), kept.end(), expected.begin(),
+                                  [](const Rectangle& a, const Rectangle& b) { return !(a < b) && !(b < a); });
+    if (!sameEntries || bounded.size() != capacity) {
+        std::cout << "  Kept " << kept.size() << " rectangles, expected the best " << capacity << "\n";
+        passed = false;
+    }
+
+    if (passed) {
+        std::cout << "[PASS] Bounded store keeps exactly the best K rectangles\n";
+    } else {
+        std::cout << "[FAIL] Bounded store kept the wrong rectangles\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return passed;
+}
+
+bool testSpiralWorkQueue() {
+    std::cout << "Testing lazy spiral work generator...\n";
+    std::cout << "========================================\n";
+
+    // Block bounds and unit size: centered, off-center, origin outside, a single strip,
+    // partial edge units, an empty search, and the smallest and largest unit sizes
+    const int64_t bounds[][5] = {
+        {-30000 * 16, 30000 * 16, -30000 * 16, 30000 * 16, WORK_UNIT_SIZE},
+        {-5000 * 16, 20000 * 16, -1000 * 16, 3000 * 16, WORK_UNIT_SIZE},
+        {100000 * 16, 104000 * 16, -90000 * 16, -80000 * 16, WORK_UNIT_SIZE},
+        {-40000 * 16, 40000 * 16, 0, 1000 * 16, WORK_UNIT_SIZE},
+        {-1234567, 2345678, -345678, 4567, WORK_UNIT_SIZE},
+        {0, 0, 0, 0, WORK_UNIT_SIZE},
+        {-1234567, 2345678, -345678, 4567, MIN_WORK_UNIT_SIZE},
+        {-5000 * 16, 200000 * 16, -100000 * 16, 3000 * 16, 300},
+        {-200000 * 16, 200000 * 16, -1000 * 16, 1000 * 16, MAX_WORK_UNIT_SIZE},
+    };
+
+    bool passed = true;
+    for (const auto& b : bounds) {
+        SpiralWorkQueue workQueue(b[0], b[1], b[2], b[3], b[4]);
+        int64_t unitCount = workQueue.size();
+        std::vector<char> seen((size_t)unitCount, 0);
+        int64_t handedOut = 0;
+        int64_t covered = 0;
+        int64_t lastRing = -1;
+        int64_t lastCenterDistance = -1;
+        bool ordered = true;
+        bool duplicate = false;
+
+        // Ring of a unit, measured from the first (innermost) unit handed out
+        int64_t centerX = 0, centerZ = 0;
+        WorkUnit unit;
+        while (workQueue.next(unit)) {
+            if (handedOut == 0) {
+                centerX = unit.minX;
+                centerZ = unit.minZ;
+            }
+            handedOut++;
+            if (unit.index < 0 || unit.index >= unitCount || seen[unit.index]) {
+                duplicate = true;
+                break;
+            }
+            seen[unit.index] = 1;
+            covered += (unit.maxX - unit.minX) * (unit.maxZ - unit.minZ);
+
+            int64_t dx = std::abs(unit.minX - centerX) / b[4];
+            int64_t dz = std::abs(unit.minZ - centerZ) / b[4];
+            int64_t ring = std::max(dx, dz);
+            int64_t centerDistance = std::min(dx, dz);
+            if (ring < lastRing || (ring == lastRing && centerDistance < lastCenterDistance)) {
+                ordered = false;
+            }
+            lastRing = ring;
+            lastCenterDistance = centerDistance;
+        }
+
+        int64_t expectedChunks = std::max<int64_t>(0, b[1] / 16 - b[0] / 16) * std::max<int64_t>(0, b[3] / 16 - b[2] / 16);
+        bool ok = !duplicate && ordered && handedOut == unitCount && covered == expectedChunks;
+        std::cout << "  Bounds X[" << b[0] << ", " << b[1] << "] Z[" << b[2] << ", " << b[3] << "] / " << b[4]
+                  << ": " << unitCount << " units, " << workQueue.spiralLength() << " spiral cells"
+                  << (ok ? "" : " [MISMATCH]") << "\n";
+        passed = passed && ok;
+    }
+
+    // The center unit holds the origin whenever the origin is inside the bounds
+    SpiralWorkQueue offCenter(-5000 * 16, 20000 * 16, -1000 * 16, 3000 * 16);
+    WorkUnit first;
+    if (!offCenter.next(first) || first.minX > 0 || first.maxX <= 0 || first.minZ > 0 || first.maxZ <= 0) {
+        std::cout << "  First unit does not contain the origin\n";
+        passed = false;
+    }
+
+    if (passed) {
+        std::cout << "[PASS] Spiral generator covers every unit once, innermost rings first\n";
+    } else {
+        std::cout << "[FAIL] Spiral generator skipped, repeated or misordered units\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return passed;
+}
+
+bool testWorkStealing() {
+    const int64_t TEST_WORLD_SEED = 413563856LL;
+
+    std::cout << "Testing work-stealing scheduler...\n";
+    std::cout << "========================================\n";
+
+    bool passed = true;
+
+    // Workers fill node 0 before node 1 and wrap past the last CPU
+    std::vector<WorkerPlacement> placement = planWorkerPlacement(5, {{0, 1}, {2, 3}});
+    const int expectedCpus[] = {0, 1, 2, 3, 0};
+    const int expectedNodes[] = {0, 0, 1, 1, 0};
+    for (int t = 0; t < 5; t++) {
+        passed = passed && placement[t].cpu == expectedCpus[t] && placement[t].node == expectedNodes[t];
+    }
+    passed = passed && planWorkerPlacement(2, {})[1].cpu == -1;
+    std::cout << "  Placement over two nodes: " << (passed ? "ok" : "wrong") << "\n";
+
+    // A single stealing worker sees exactly the shared spiral order
+    const int64_t searchMinX = -5000 * 16, searchMaxX = 20000 * 16, searchMinZ = -1000 * 16, searchMaxZ = 3000 * 16;
+    SpiralWorkQueue shared(searchMinX, searchMaxX, searchMinZ, searchMaxZ, 300);
+    SpiralWorkQueue single(searchMinX, searchMaxX, searchMinZ, searchMaxZ, 300);
+    single.enableStealing(planWorkerPlacement(1, {}));
+    WorkUnit a, b;
+    bool sameOrder = true;
+    while (shared.next(a)) {
+        sameOrder = sameOrder && single.next(b, 0) && a.index == b.index;
+    }
+    sameOrder = sameOrder && !single.next(b, 0);
+    std::cout << "  Single worker order: " << (sameOrder ? "same as shared" : "differs") << "\n";
+    passed = passed && sameOrder;
+
+    // A worker that runs dry steals the far half of a busy worker's range; every unit is
+    // still handed out once
+    SpiralWorkQueue pair(searchMinX, searchMaxX, searchMinZ, searchMaxZ, 300);
+    pair.enableStealing(planWorkerPlacement(2, {{0}, {1}}));
+    std::vector<int64_t> claims((size_t)pair.size(), 0);
+    WorkUnit unit;
+    bool firstClaimed = pair.next(unit, 0);
+    if (firstClaimed) claims[unit.index]++;
+    while (pair.next(unit, 1)) claims[unit.index]++;
+    int64_t stolen = pair.steals();
+    while (pair.next(unit, 0)) claims[unit.index]++;
+    bool once = firstClaimed && std::all_of(claims.begin(), claims.end(), [](int64_t c) { return c == 1; });
+    std::cout << "  Two workers: " << stolen << " steal(s), every unit once: " << (once ? "yes" : "no") << "\n";
+    passed = passed && once && stolen > 0;
+
+    // Concurrent claims from pinned workers cover every unit once
+    std::vector<std::vector<int>> nodes = detectNumaNodes();
+    const int64_t threadCount = 4;
+    std::vector<WorkerPlacement> pinned = planWorkerPlacement(threadCount, nodes);
+    SpiralWorkQueue contended(searchMinX, searchMaxX, searchMinZ, searchMaxZ, MIN_WORK_UNIT_SIZE);
+    contended.enableStealing(pinned);
+    std::vector<std::atomic<int64_t>> counts((size_t)contended.size());
+    for (auto& count : counts) count.store(0);
+    std::vector<std::thread> threads;
+    for (int64_t t = 0; t < threadCount; t++) {
+        threads.emplace_back([&, t] {
+            pinCurrentThread(pinned[t].cpu);
+            WorkUnit claimed;
+            while (contended.next(claimed, t)) {
+                counts[claimed.index].fetch_add(1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    bool concurrentOnce = std::all_of(counts.begin(), counts.end(), [](const std::atomic<int64_t>& c) { return c.load() == 1; });
+    std::cout << "  " << threadCount << " workers on " << nodes.size() << " node(s), " << contended.size()
+              << " units: every unit once: " << (concurrentOnce ? "yes" : "no") << "\n";
+    passed = passed && concurrentOnce;
+
+    // Full searches find the same rectangles with either scheduler
+    auto runSearch = [&](Scheduler scheduler) {
+        int64_t minX = -600 * 16, maxX = 700 * 16, minZ = -500 * 16, maxZ = 550 * 16;
+        EngineConfig engines;
+        engines.simdLevel = detectSimdLevel();
+        engines.scheduler = scheduler;
+        std::vector<WorkerPlacement> workers = planWorkerPlacement(3, nodes);
+        engines.placement = &workers;
+        RectangleStore results;
+        std::atomic<bool> pauseFlag{false};
+        std::atomic<int64_t> chunksProcessed{0};
+        std::atomic<int64_t> maxDistanceReached{0};
+        SpiralWorkQueue workQueue(minX, maxX, minZ, maxZ, 100);
+        if (scheduler == Scheduler::Stealing) {
+            workQueue.enableStealing(workers);
+        }
+        WorkProgress progress(workQueue.size());
+        SeamTracker seams(workQueue, progress);
+        std::vector<std::thread> workerThreads;
+        for (int64_t i = 0; i < 3; i++) {
+            workerThreads.emplace_back(workerThread, i, 3, TEST_WORLD_SEED, 2, minX, maxX, minZ, maxZ,
+                                       std::ref(results), std::ref(pauseFlag), std::ref(chunksProcessed),
+                                       std::ref(maxDistanceReached), std::ref(workQueue), std::ref(progress),
+                                       std::ref(seams), std::cref(engines), false);
+        }
+        for (auto& thread : workerThreads) {
+            thread.join();
+        }
+        return results.snapshot();
+    };
+    std::vector<Rectangle> sharedFound = runSearch(Scheduler::Shared);
+    std::vector<Rectangle> stealingFound = runSearch(Scheduler::Stealing);
+    bool sameFound = !sharedFound.empty() && sharedFound.size() == stealingFound.size() &&
+                     std::equal(sharedFound.begin(), sharedFound.end(), stealingFound.begin(),
+                                [](const Rectangle& x, const Rectangle& y) { return !(x < y) && !(y < x); });
+    std::cout << "  Search: " << sharedFound.size() << " rectangles shared, " << stealingFound.size()
+              << " stealing\n";
+    passed = passed && sameFound;
+
+    if (passed) {
+        std::cout << "[PASS] Work stealing hands out every unit once, closest first\n";
+    } else {
+        std::cout << "[FAIL] Work stealing lost, repeated or reordered units\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return passed;
+}
+
+bool testCheckpointResume() {
+    const int64_t TEST_WORLD_SEED = 413563856LL;
+
+    std::cout << "Testing checkpoint and resume...\n";
+    std::cout << "========================================\n";
+
+    // 3 x 2 work units; 2x2 minimum so there are plenty of rectangles to lose
+    int64_t searchMinX = 0;
+    int64_t searchMaxX = 3000 * 16;
+    int64_t searchMinZ = 7400 * 16;
+    int64_t searchMaxZ = 9400 * 16;
+    int64_t unitCount = SpiralWorkQueue(searchMinX, searchMaxX, searchMinZ, searchMaxZ).size();
+
+    EngineConfig engines;
+    engines.simdLevel = detectSimdLevel();
+
+    // claimedAhead units are taken off the queue before the worker starts and never
+    // finished, as if the process died while scanning them
+    auto runQueue = [&](RectangleStore& results, WorkProgress& progress, std::atomic<int64_t>& chunksProcessed,
+                        int64_t claimedAhead) {
+        std::atomic<bool> pauseFlag{false};
+        std::atomic<int64_t> maxDistanceReached{0};
+        SpiralWorkQueue workQueue(searchMinX, searchMaxX, searchMinZ, searchMaxZ);
+        SeamTracker seams(workQueue, progress);
+        WorkUnit lost;
+        for (int64_t i = 0; i < claimedAhead; i++) {
+            workQueue.next(lost);
+        }
+        workerThread(0, 1, TEST_WORLD_SEED, 2, searchMinX, searchMaxX, searchMinZ, searchMaxZ,
+                     results, pauseFlag, chunksProcessed, maxDistanceReached, workQueue, progress, seams, engines);
+    };
+
+    // Reference: one uninterrupted run
+    RectangleStore fullResults;
+    WorkProgress fullProgress(unitCount);
+    std::atomic<int64_t> fullChunks{0};
+    runQueue(fullResults, fullProgress, fullChunks, 0);
+
+    // Interrupted run: the first unit never finishes, so neither do the neighbours whose
+    // seams depend on its edges
+    RectangleStore partialResults;
+    WorkProgress partialProgress(unitCount);
+    std::atomic<int64_t> partialChunks{0};
+    runQueue(partialResults, partialProgress, partialChunks, 1);
+
+    // Chunk count as the main program saves it: only units marked complete
+    SpiralWorkQueue unitGrid(searchMinX, searchMaxX, searchMinZ, searchMaxZ);
+    int64_t completedChunks = 0;
+    for (int64_t i = 0; i < unitCount; i++) {
+        if (partialProgress.isDone(i)) {
+            WorkUnit work = unitGrid.unitAt(i);
+            completedChunks += (work.maxX - work.minX) * (work.maxZ - work.minZ);
+        }
+    }
+    int64_t partialCompleted = partialProgress.completedCount();
+
+    Checkpoint saved;
+    saved.worldSeeds = {TEST_WORLD_SEED};
+    saved.searchMinX = searchMinX;
+    saved.searchMaxX = searchMaxX;
+    saved.searchMinZ = searchMinZ;
+    saved.searchMaxZ = searchMaxZ;
+    saved.minimumRectDimension = 2;
+    saved.workUnitSize = WORK_UNIT_SIZE;
+    saved.rectMode = (int64_t)engines.rectMode;
+    saved.tiling = (int64_t)engines.tiling;
+    saved.unitCount = unitCount;
+    saved.chunksProcessed = completedChunks;
+    saved.completedUnits = partialProgress.snapshotWords();
+    saved.rectangles = {partialResults.snapshot()};
+
+    std::string path = (std::filesystem::temp_directory_path() / "slimechunk_test.ckpt").string();
+    bool passed = saveCheckpoint(path, saved);
+
+    // Resume into fresh state
+    Checkpoint loaded;
+    passed = passed && loadCheckpoint(path, loaded) && loaded.sameSearch(saved);
+    RectangleStore resumedResults;
+    WorkProgress resumedProgress(unitCount);
+    std::atomic<int64_t> resumedChunks{0};
+    if (passed) {
+        passed = resumedProgress.loadWords(loaded.completedUnits) && partialCompleted > 0 &&
+                 resumedProgress.completedCount() == partialCompleted && partialCompleted < unitCount;
+        resumedChunks = loaded.chunksProcessed;
+        resumedResults.insertBatch(loaded.rectangles[0], true);
+        runQueue(resumedResults, resumedProgress, resumedChunks, 0);
+    }
+
+    std::vector<Rectangle> expected = fullResults.snapshot();
+    std::vector<Rectangle> resumed = resumedResults.snapshot();
+    bool sameResults = expected.size() == resumed.size() &&
+                       std::equal(expected.begin(), expected.end(), resumed.begin(),
+                                  [](const Rectangle& a, const Rectangle& b) { return !(a < b) && !(b < a); });
+    std::cout << "  Units: " << unitCount << " (" << partialCompleted << " done when interrupted), uninterrupted "
+              << expected.size() << " rectangles, resumed " << resumed.size() << "\n";
+    passed = passed && sameResults && resumedChunks.load() == fullChunks.load() &&
+             resumedProgress.completedCount() == unitCount;
+
+    // A damaged file must be rejected rather than silently resumed
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(100);
+        file.put('\x5a');
+    }
+    Checkpoint damaged;
+    if (loadCheckpoint(path, damaged)) {
+        std::cout << "  Corrupted checkpoint was accepted\n";
+        passed = false;
+    }
+    std::filesystem::remove(path);
+
+    if (passed) {
+        std::cout << "[PASS] Resumed search matches an uninterrupted one\n";
+    } else {
+        std::cout << "[FAIL] Checkpoint round trip lost or changed results\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return passed;
+}
+
+bool testSeamTiling() {
+    const int64_t TEST_WORLD_SEED = 413563856LL;
+
+    std::cout << "Testing seam and padded tiling against a single whole-region scan...\n";
+    std::cout << "========================================\n";
+
+    // 3 x 3 default units (13 x 11 small ones) with partial units along the far edges,
+    // straddling the origin
+    int64_t searchMinX = -1000 * 16;
+    int64_t searchMaxX = 1500 * 16;
+    int64_t searchMinZ = -900 * 16;
+    int64_t searchMaxZ = 1200 * 16;
+    int64_t minX = searchMinX / 16;
+    int64_t minZ = searchMinZ / 16;
+
+    SlimeGrid region(searchMaxZ / 16 - minZ, searchMaxX / 16 - minX);
+    for (int64_t r = 0; r < region.rows; r++) {
+        for (int64_t c = 0; c < region.cols; c++) {
+            if (isSlimeChunk(minX + c, minZ + r, TEST_WORLD_SEED)) {
+                region.set(r, c);
+            }
+        }
+    }
+
+    bool passed = true;
+    const RectFilter filters[2] = {RectFilter::None, RectFilter::SquareAnd};
+    for (int64_t n = 1; n <= 2; n++) {
+        std::vector<Rectangle> whole;
+        findMaximalRectangles(region, 0, region.rows, minX, minZ, n, whole, RectMode::Maximal);
+        std::sort(whole.begin(), whole.end());
+
+        for (RectFilter filter : filters) {
+            // (threads, unit size)
+            const int64_t runs[][2] = {{1, WORK_UNIT_SIZE}, {3, WORK_UNIT_SIZE}, {3, 200}};
+            for (const auto& run : runs) {
+                for (Tiling tiling : {Tiling::Seams, Tiling::Padded}) {
+                    int64_t numThreads = run[0];
+                    RectangleStore results;
+                    std::atomic<bool> pauseFlag{false};
+                    std::atomic<int64_t> chunksProcessed{0};
+                    std::atomic<int64_t> maxDistanceReached{0};
+                    EngineConfig engines;
+                    engines.simdLevel = detectSimdLevel();
+                    engines.rectFilter = filter;
+                    engines.tiling = tiling;
+
+                    SpiralWorkQueue workQueue(searchMinX, searchMaxX, searchMinZ, searchMaxZ, run[1]);
+                    WorkProgress progress(workQueue.size());
+                    SeamTracker seams(workQueue, progress);
+                    std::vector<std::thread> threads;
+                    for (int64_t i = 0; i < numThreads; i++) {
+                        threads.emplace_back(workerThread, i, numThreads, TEST_WORLD_SEED, n,
+                                             searchMinX, searchMaxX, searchMinZ, searchMaxZ,
+                                             std::ref(results), std::ref(pauseFlag), std::ref(chunksProcessed),
+                                             std::ref(maxDistanceReached), std::ref(workQueue), std::ref(progress),
+                                             std::ref(seams), std::cref(engines), false);
+                    }
+                    for (auto& thread : threads) {
+                        thread.join();
+                    }
+
+                    std::vector<Rectangle> tiled = results.snapshot();
+                    bool same = tiled.size() == whole.size() &&
+                                std::equal(tiled.begin(), tiled.end(), whole.begin(),
+                                           [](const Rectangle& a, const Rectangle& b) {
+                                               return !(a < b) && !(b < a);
+                                           });
+                    bool clean = seams.trackedUnits() == 0 && progress.completedCount() == workQueue.size() &&
+                                 chunksProcessed.load() == region.rows * region.cols;
+                    std::cout << "  n=" << n << " filter=" << rectFilterName(filter) << " threads=" << numThreads
+                              << " unit=" << run[1] << " tiling=" << tilingName(tiling)
+                              << ": whole " << whole.size() << ", tiled " << tiled.size()
+                              << (clean ? "" : " (units left unsettled)") << "\n";
+                    passed = passed && same && clean;
+                }
+            }
+        }
+    }
+
+    if (passed) {
+        std::cout << "[PASS] Seam and padded tiling match the whole-region scan\n";
+    } else {
+        std::cout << "[FAIL] Seam or padded tiling lost, duplicated or invented rectangles\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return passed;
+}
+
+bool testPaddedTiling() {
+    std::cout << "Testing padded tiling against a single whole-region scan...\n";
+    std::cout << "========================================\n";
+
+    // (seed, half side in blocks, unit size): small units make rectangles reaching past the
+    // padding common, and N = 1 has long runs across every unit edge
+    const int64_t cases[][3] = {
+        {12345LL, 4096, 64},
+        {413563856LL, 6400, 200},
+        {-987654321LL, 4096, MIN_WORK_UNIT_SIZE},
+    };
+
+    bool passed = true;
+    for (const auto& c : cases) {
+        int64_t worldSeed = c[0];
+        int64_t searchMin = -c[1], searchMax = c[1] + 16 * 7;   // Partial units on the far edges
+        int64_t minChunk = searchMin / 16;
+        SlimeGrid region(searchMax / 16 - minChunk, searchMax / 16 - minChunk);
+        for (int64_t r = 0; r < region.rows; r++) {
+            for (int64_t col = 0; col < region.cols; col++) {
+                if (isSlimeChunk(minChunk + col, minChunk + r, worldSeed)) {
+                    region.set(r, col);
+                }
+            }
+        }
+
+        for (int64_t n = 1; n <= 2; n++) {
+            std::vector<Rectangle> whole;
+            findMaximalRectangles(region, 0, region.rows, minChunk, minChunk, n, whole, RectMode::Maximal);
+            std::sort(whole.begin(), whole.end());
+
+            for (RectFilter filter : {RectFilter::None, RectFilter::SquareAnd}) {
+                RectangleStore results;
+                std::atomic<bool> pauseFlag{false};
+                std::atomic<int64_t> chunksProcessed{0};
+                std::atomic<int64_t> maxDistanceReached{0};
+                EngineConfig engines;
+                engines.simdLevel = detectSimdLevel();
+                engines.rectFilter = filter;
+                engines.tiling = Tiling::Padded;
+
+                SpiralWorkQueue workQueue(searchMin, searchMax, searchMin, searchMax, c[2]);
+                WorkProgress progress(workQueue.size());
+                SeamTracker seams(workQueue, progress);
+                std::vector<std::thread> threads;
+                for (int64_t i = 0; i < 2; i++) {
+                    threads.emplace_back(workerThread, i, 2, worldSeed, n, searchMin, searchMax, searchMin, searchMax,
+                                         std::ref(results), std::ref(pauseFlag), std::ref(chunksProcessed),
+                                         std::ref(maxDistanceReached), std::ref(workQueue), std::ref(progress),
+                                         std::ref(seams), std::cref(engines), false);
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+
+                std::vector<Rectangle> tiled = results.snapshot();
+                bool same = tiled.size() == whole.size() &&
+                            std::equal(tiled.begin(), tiled.end(), whole.begin(),
+                                       [](const Rectangle& a, const Rectangle& b) { return !(a < b) && !(b < a); });
+                std::cout << "  seed=" << worldSeed << " unit=" << c[2] << " n=" << n
+                          << " filter=" << rectFilterName(filter) << ": whole " << whole.size()
+                          << ", padded " << tiled.size() << (same ? "" : " [MISMATCH]") << "\n";
+                passed = passed && same;
+            }
+        }
+    }
+
+    if (passed) {
+        std::cout << "[PASS] Padded tiling matches the whole-region scan\n";
+    } else {
+        std::cout << "[FAIL] Padded tiling reported fragments or lost rectangles\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return passed;
+}
+
+bool testMultiSeed() {
+    std::cout << "Testing multi-seed batches against whole-region scans and single-seed runs...\n";
+    std::cout << "========================================\n";
+
+    const std::vector<int64_t> seeds = {413563856LL, -1LL, 0x7FFFFFFFFFFFLL, 12345LL, -987654321LL};
+    int64_t searchMinX = -700 * 16;
+    int64_t searchMaxX = 900 * 16;
+    int64_t searchMinZ = -500 * 16;
+    int64_t searchMaxZ = 800 * 16;
+    const int64_t unitSize = 300;
+    const int64_t n = 2;
+
+    // Maximal mode reference: each seed's maximal rectangles from one whole-region scan
+    std::vector<std::vector<Rectangle>> whole(seeds.size());
+    SlimeGrid region((searchMaxZ - searchMinZ) / 16, (searchMaxX - searchMinX) / 16);
+    for (size_t k = 0; k < seeds.size(); k++) {
+        region.resize((searchMaxZ - searchMinZ) / 16, (searchMaxX - searchMinX) / 16);
+        for (int64_t r = 0; r < region.rows; r++) {
+            for (int64_t c = 0; c < region.cols; c++) {
+                if (isSlimeChunk(searchMinX / 16 + c, searchMinZ / 16 + r, seeds[k])) {
+                    region.set(r, c);
+                }
+            }
+        }
+        findMaximalRectangles(region, 0, region.rows, searchMinX / 16, searchMinZ / 16, n, whole[k],
+                              RectMode::Maximal);
+        std::sort(whole[k].begin(), whole[k].end());
+    }
+
+    bool passed = true;
+    const RectFilter filters[2] = {RectFilter::None, RectFilter::SquareAnd};
+    const RectMode modes[2] = {RectMode::Maximal, RectMode::Exhaustive};
+    for (RectMode mode : modes) {
+        for (RectFilter filter : filters) {
+            EngineConfig engines;
+            engines.simdLevel = detectSimdLevel();
+            engines.rectFilter = filter;
+            engines.rectMode = mode;
+            engines.tiling = Tiling::Padded;
+
+            std::vector<std::unique_ptr<RectangleStore>> batched;
+            for (size_t k = 0; k < seeds.size(); k++) {
+                batched.push_back(std::make_unique<RectangleStore>());
+            }
+            std::atomic<bool> pauseFlag{false};
+            std::atomic<int64_t> chunksProcessed{0};
+            std::atomic<int64_t> maxDistanceReached{0};
+            SpiralWorkQueue workQueue(searchMinX, searchMaxX, searchMinZ, searchMaxZ, unitSize);
+            WorkProgress progress(workQueue.size());
+            std::vector<std::thread> threads;
+            for (int64_t i = 0; i < 3; i++) {
+                threads.emplace_back(multiSeedWorkerThread, i, std::cref(seeds), n,
+                                     searchMinX, searchMaxX, searchMinZ, searchMaxZ,
+                                     std::ref(batched), std::ref(pauseFlag), std::ref(chunksProcessed),
+                                     std::ref(maxDistanceReached), std::ref(workQueue), std::ref(progress),
+                                     std::cref(engines), false);
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            bool complete = progress.completedCount() == workQueue.size() &&
+                            chunksProcessed.load() == (searchMaxX - searchMinX) / 16 * ((searchMaxZ - searchMinZ) / 16);
+
+            size_t totalFound = 0;
+            bool same = true;
+            for (size_t k = 0; k < seeds.size(); k++) {
+                // Exhaustive mode reports what its padded grids hold, so it is checked
+                // against a single-seed run with the same tiling instead
+                std::vector<Rectangle> expected = whole[k];
+                if (mode == RectMode::Exhaustive) {
+                    RectangleStore single;
+                    std::atomic<int64_t> singleChunks{0};
+                    SpiralWorkQueue singleQueue(searchMinX, searchMaxX, searchMinZ, searchMaxZ, unitSize);
+                    WorkProgress singleProgress(singleQueue.size());
+                    SeamTracker seams(singleQueue, singleProgress);
+                    workerThread(0, 1, seeds[k], n, searchMinX, searchMaxX, searchMinZ, searchMaxZ,
+                                 single, pauseFlag, singleChunks, maxDistanceReached,
+                                 singleQueue, singleProgress, seams, engines);
+                    expected = single.snapshot();
+                }
+                std::vector<Rectangle> actual = batched[k]->snapshot();
+                same = same && expected.size() == actual.size() &&
+                       std::equal(expected.begin(), expected.end(), actual.begin(),
+                                  [](const Rectangle& a, const Rectangle& b) { return !(a < b) && !(b < a); });
+                totalFound += actual.size();
+            }
+            std::cout << "  mode=" << rectModeName(mode) << " filter=" << rectFilterName(filter)
+                      << ": " << seeds.size() << " seeds, " << totalFound << " rectangles"
+                      << (same ? "" : " (differs from the reference)")
+                      << (complete ? "" : " (units left unfinished)") << "\n";
+            passed = passed && same && complete;
+        }
+    }
+
+    if (passed) {
+        std::cout << "[PASS] Multi-seed batches match the whole-region and single-seed references\n";
+    } else {
+        std::cout << "[FAIL] Multi-seed batches disagree with the reference scans\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return passed;
+}
+
+bool testSeedSweep() {
+    std::cout << "Testing the seed sweep against per-seed brute force...\n";
+    std::cout << "========================================\n";
+
+    // 48 x 40 chunks around spawn, 300 seeds: four full blocks and a partial one
+    const int64_t minX = -24, maxX = 24, minZ = -20, maxZ = 20;
+    const int64_t seedStart = 1000, seedEnd = 1300;
+    const int64_t minDim = 2;
+    const int64_t topK = 25;
+
+    // Reference: each seed's best maximal rectangle from an isSlimeChunk grid
+    std::vector<SeedRectangle> expected;
+    SlimeGrid grid(maxZ - minZ, maxX - minX);
+    for (int64_t seed = seedStart; seed < seedEnd; seed++) {
+        grid.resize(maxZ - minZ, maxX - minX);
+        for (int64_t r = 0; r < grid.rows; r++) {
+            for (int64_t c = 0; c < grid.cols; c++) {
+                if (isSlimeChunk(minX + c, minZ + r, seed)) {
+                    grid.set(r, c);
+                }
+            }
+        }
+        std::vector<Rectangle> found;
+        findMaximalRectangles(grid, 0, grid.rows, minX, minZ, minDim, found);
+        if (!found.empty()) {
+            expected.push_back({seed, *std::min_element(found.begin(), found.end())});
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+    if ((int64_t)expected.size() > topK) {
+        expected.resize(topK);
+    }
+
+    auto sameEntries = [](const std::vector<SeedRectangle>& a, const std::vector<SeedRectangle>& b) {
+        return a.size() == b.size() &&
+               std::equal(a.begin(), a.end(), b.begin(), [](const SeedRectangle& x, const SeedRectangle& y) {
+                   return !(x < y) && !(y < x);
+               });
+    };
+
+    // The grid budget takes whole blocks of small regions and rejects a full-size one
+    bool budgetOK = seedSweepPassSeeds(maxX - minX, maxZ - minZ) == SEED_SWEEP_BLOCK_SIZE &&
+                    seedSweepPassSeeds(MAX_WORK_UNIT_SIZE, MAX_WORK_UNIT_SIZE) == 0 &&
+                    seedSweepPassSeeds(8192, 8192) * 8192 * 8192 / 8 <= SEED_SWEEP_GRID_BUDGET;
+    if (!budgetOK) {
+        std::cout << "  seed grid budget sized the passes wrong\n";
+    }
+
+    bool passed = !expected.empty() && budgetOK;
+    const RectFilter filters[2] = {RectFilter::None, RectFilter::SquareAnd};
+    for (RectFilter filter : filters) {
+        EngineConfig engines;
+        engines.simdLevel = detectSimdLevel();
+        engines.rectFilter = filter;
+
+        // Interrupted run: blocks 0 and 2 finish, block 1 is still in flight. Five grids
+        // split each block into passes, as a region over the grid budget would.
+        SeedResultStore partial(topK);
+        SeedSweepQueue partialQueue(seedStart, seedEnd);
+        std::vector<SlimeGrid> grids(5);
+        std::vector<SeedRectangle> batch;
+        int64_t claimed[3];
+        for (int64_t& block : claimed) {
+            partialQueue.next(block);
+        }
+        for (int64_t block : {claimed[2], claimed[0]}) {
+            processSeedBlock(partialQueue.firstSeed(block), partialQueue.seedCount(block), minX, maxX, minZ, maxZ,
+                             minDim, partial.admissionArea(), grids, batch, engines);
+            partial.insertBatch(batch);
+            partialQueue.markDone(block);
+        }
+        bool watermarkOK = partialQueue.blockCount() == 5 && partialQueue.completedBlocks() == 1;
+
+        SeedSweepCheckpoint saved;
+        saved.seedStart = seedStart;
+        saved.seedEnd = seedEnd;
+        saved.searchMinX = minX * 16;
+        saved.searchMaxX = maxX * 16;
+        saved.searchMinZ = minZ * 16;
+        saved.searchMaxZ = maxZ * 16;
+        saved.minimumRectDimension = minDim;
+        saved.completedBlocks = partialQueue.completedBlocks();
+        saved.results = partial.snapshot();
+        partialQueue.markDone(claimed[1]);
+        watermarkOK = watermarkOK && partialQueue.completedBlocks() == 3;
+
+        std::string path = (std::filesystem::temp_directory_path() / "slimechunk_sweep_test.ckpt").string();
+        SeedSweepCheckpoint loaded;
+        bool resumedOK = saveSeedSweepCheckpoint(path, saved) && loadSeedSweepCheckpoint(path, loaded) &&
+                         loaded.sameSweep(saved) && loaded.completedBlocks == 1 &&
+                         sameEntries(loaded.results, saved.results);
+        std::filesystem::remove(path);
+
+        // Resume on three threads from the watermark; block 2 is simply redone
+        SeedResultStore results(topK);
+        results.insertBatch(loaded.results);
+        SeedSweepQueue queue(seedStart, seedEnd, loaded.completedBlocks);
+        std::atomic<bool> pauseFlag{false};
+        std::atomic<int64_t> seedsProcessed{0};
+        std::vector<std::thread> threads;
+        for (int64_t i = 0; i < 3; i++) {
+            threads.emplace_back(seedSweepThread, i, minX, maxX, minZ, maxZ, minDim, std::ref(queue),
+                                 std::ref(results), std::ref(pauseFlag), std::ref(seedsProcessed),
+                                 std::cref(engines));
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        std::vector<SeedRectangle> swept = results.snapshot();
+        bool same = sameEntries(swept, expected);
+        std::cout << "  filter=" << rectFilterName(filter) << ": " << swept.size() << " seeds kept, best "
+                  << (swept.empty() ? 0 : swept[0].rect.area) << " (seed "
+                  << (swept.empty() ? 0 : swept[0].worldSeed) << ")"
+                  << (watermarkOK ? "" : " (watermark wrong)") << (resumedOK ? "" : " (checkpoint lost state)")
+                  << "\n";
+        passed = passed && same && watermarkOK && resumedOK &&
+                 queue.completedBlocks() == queue.blockCount() && seedsProcessed.load() == seedEnd - seedStart - 64;
+    }
+
+    if (passed) {
+        std::cout << "[PASS] Seed sweep keeps the same best seeds as brute force\n";
+    } else {
+        std::cout << "[FAIL] Seed sweep disagrees with brute force\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return passed;
+}
+
+bool testBitmapCache() {
+    const int64_t TEST_WORLD_SEED = 413563856LL;
+
+    std::cout << "Testing the memory-mapped bitmap cache...\n";
+    std::cout << "========================================\n";
+
+    // 13 x 11 units of 200 chunks with partial units along the far edges
+    int64_t searchMinX = -1000 * 16;
+    int64_t searchMaxX = 1500 * 16;
+    int64_t searchMinZ = -900 * 16;
+    int64_t searchMaxZ = 1200 * 16;
+    const int64_t unitSize = 200;
+
+    auto runSearch = [&](const EngineConfig& engines, int64_t n) {
+        RectangleStore results;
+        std::atomic<bool> pauseFlag{false};
+        std::atomic<int64_t> chunksProcessed{0};
+        std::atomic<int64_t> maxDistanceReached{0};
+        SpiralWorkQueue workQueue(searchMinX, searchMaxX, searchMinZ, searchMaxZ, unitSize);
+        WorkProgress progress(workQueue.size());
+        SeamTracker seams(workQueue, progress);
+        std::vector<std::thread> threads;
+        for (int64_t i = 0; i < 3; i++) {
+            threads.emplace_back(workerThread, i, 3, TEST_WORLD_SEED, n,
+                                 searchMinX, searchMaxX, searchMinZ, searchMaxZ,
+                                 std::ref(results), std::ref(pauseFlag), std::ref(chunksProcessed),
+                                 std::ref(maxDistanceReached), std::ref(workQueue), std::ref(progress),
+                                 std::ref(seams), std::cref(engines), false);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return results.snapshot();
+    };
+    auto sameRectangles = [](const std::vector<Rectangle>& a, const std::vector<Rectangle>& b) {
+        return a.size() == b.size() &&
+               std::equal(a.begin(), a.end(), b.begin(),
+                          [](const Rectangle& x, const Rectangle& y) { return !(x < y) && !(y < x); });
+    };
+
+    EngineConfig hashed;
+    hashed.simdLevel = detectSimdLevel();
+    hashed.rectFilter = RectFilter::None;
+    EngineConfig hashedPadded = hashed;
+    hashedPadded.tiling = Tiling::Padded;
+
+    std::string path = (std::filesystem::temp_directory_path() / "slimechunk_test.bitmap").string();
+    std::filesystem::remove(path);
+    SpiralWorkQueue unitGrid(searchMinX, searchMaxX, searchMinZ, searchMaxZ, unitSize);
+
+    bool passed = true;
+    {
+        // First run fills every tile; the padded run then reads rows that cross tiles
+        BitmapCache cache;
+        passed = cache.open(path, TEST_WORLD_SEED, unitGrid) && cache.validTiles() == 0;
+        EngineConfig cached = hashed;
+        cached.bitmapCache = &cache;
+        EngineConfig cachedPadded = hashedPadded;
+        cachedPadded.bitmapCache = &cache;
+
+        bool seamsSame = sameRectangles(runSearch(cached, 2), runSearch(hashed, 2));
+        bool paddedSame = sameRectangles(runSearch(cachedPadded, 3), runSearch(hashedPadded, 3));
+        std::cout << "  Fresh cache: " << cache.tilesFilled() << "/" << cache.tileCount() << " tiles filled"
+                  << (seamsSame ? "" : ", seam run differs") << (paddedSame ? "" : ", padded run differs") << "\n";
+        passed = passed && seamsSame && paddedSame && cache.tilesFilled() == cache.tileCount() &&
+                 cache.validTiles() == cache.tileCount();
+
+        // 1 bit per chunk rounded up to whole words per tile row: 200 chunks take 4 words,
+        // after the header page and the page of valid bytes
+        uint64_t tileBytes = unitSize * ((unitSize + 63) / 64) * sizeof(uint64_t);
+        uint64_t expectedBytes = 4096 + ((uint64_t)cache.tileCount() + 4095) / 4096 * 4096 +
+                                 (uint64_t)cache.tileCount() * tileBytes;
+        bool packed = std::filesystem::file_size(path) == expectedBytes;
+        std::cout << "  File size " << std::filesystem::file_size(path) << " bytes"
+                  << (packed ? "" : " (expected " + std::to_string(expectedBytes) + ")") << "\n";
+        passed = passed && packed;
+    }
+    {
+        // Reopened, every tile is read back and nothing is hashed into it again
+        BitmapCache cache;
+        bool reopened = cache.open(path, TEST_WORLD_SEED, unitGrid) && cache.validTiles() == cache.tileCount();
+        EngineConfig cached = hashed;
+        cached.bitmapCache = &cache;
+        bool same = reopened && sameRectangles(runSearch(cached, 1), runSearch(hashed, 1));
+
+        // Rows read straight back, starting mid-tile and crossing tile edges
+        bool rowsSame = true;
+        std::vector<uint64_t> rowBits((searchMaxX - searchMinX) / 16 / 64 + 2);
+        for (int64_t chunkZ : {searchMinZ / 16, (int64_t)-1, (int64_t)0, (int64_t)437, searchMaxZ / 16 - 1}) {
+            for (int64_t startChunkX : {searchMinX / 16, searchMinX / 16 + 137, (int64_t)-63}) {
+                int64_t count = searchMaxX / 16 - startChunkX - 5;
+                cache.readRow(startChunkX, chunkZ, count, rowBits.data(), cached);
+                for (int64_t i = 0; i < count; i++) {
+                    bool bit = (rowBits[i >> 6] >> (i & 63)) & 1;
+                    rowsSame = rowsSame && bit == isSlimeChunk(startChunkX + i, chunkZ, TEST_WORLD_SEED);
+                }
+            }
+        }
+        std::cout << "  Reopened cache: " << cache.validTiles() << " tiles valid, " << cache.tilesFilled()
+                  << " filled" << (same ? "" : ", run differs") << (rowsSame ? "" : ", rows differ") << "\n";
+        passed = passed && same && rowsSame && cache.tilesFilled() == 0;
+    }
+    {
+        // A file for another seed or unit grid is never reused
+        BitmapCache cache;
+        SpiralWorkQueue otherGrid(searchMinX, searchMaxX, searchMinZ, searchMaxZ, 256);
+        bool rejected = !cache.open(path, TEST_WORLD_SEED + 1, unitGrid) && !cache.open(path, TEST_WORLD_SEED, otherGrid);
+        std::cout << "  Mismatched seed and unit size " << (rejected ? "rejected" : "ACCEPTED") << "\n";
+        passed = passed && rejected;
+    }
+    std::filesystem::remove(path);
+
+    if (passed) {
+        std::cout << "[PASS] Cached runs match hashed runs\n";
+    } else {
+        std::cout << "[FAIL] Bitmap cache returned different slime bits\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return passed;
+}
+
+bool testResultLog() {
+    const int64_t TEST_WORLD_SEED = 413563856LL;
+
+    std::cout << "Testing the incremental result log...\n";
+    std::cout << "========================================\n";
+
+    int64_t searchMinX = -1000 * 16;
+    int64_t searchMaxX = 1500 * 16;
+    int64_t searchMinZ = -900 * 16;
+    int64_t searchMaxZ = 1200 * 16;
+    const int64_t unitSize = 200;
+
+    EngineConfig engines;
+    engines.simdLevel = detectSimdLevel();
+    engines.rectFilter = RectFilter::None;
+
+    bool passed = true;
+    // Unbounded store, then a bounded one that evicts rectangles already in the log
+    for (int64_t capacity : {(int64_t)0, (int64_t)40}) {
+        std::string path = (std::filesystem::temp_directory_path() / "slimechunk_test.log").string();
+        ResultHandoff handoff;
+        ResultLog log;
+        log.open(path, false);
+
+        RectangleStore results(capacity);
+        results.setHandoff(&handoff);
+        std::atomic<bool> pauseFlag{false};
+        std::atomic<int64_t> chunksProcessed{0};
+        std::atomic<int64_t> maxDistanceReached{0};
+        SpiralWorkQueue workQueue(searchMinX, searchMaxX, searchMinZ, searchMaxZ, unitSize);
+        WorkProgress progress(workQueue.size());
+        SeamTracker seams(workQueue, progress);
+        std::vector<std::thread> threads;
+        for (int64_t i = 0; i < 3; i++) {
+            threads.emplace_back(workerThread, i, 3, TEST_WORLD_SEED, 2,
+                                 searchMinX, searchMaxX, searchMinZ, searchMaxZ,
+                                 std::ref(results), std::ref(pauseFlag), std::ref(chunksProcessed),
+                                 std::ref(maxDistanceReached), std::ref(workQueue), std::ref(progress),
+                                 std::ref(seams), std::cref(engines), false);
+        }
+        // Drain while the workers are still pushing
+        int64_t logged = 0;
+        while (progress.completedCount() < workQueue.size()) {
+            logged += log.appendFrom(handoff);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        logged += log.appendFrom(handoff);
+
+        // Resubmitting everything (as a resume does) only adds duplicates to the log
+        std::vector<Rectangle> expected = results.snapshot();
+        std::vector<Rectangle> again = expected;
+        results.insertBatch(again, true);
+        logged += log.appendFrom(handoff);
+
+        std::vector<Rectangle> compacted;
+        bool read = compactResultLog(path, capacity, compacted);
+        bool same = read && compacted.size() == expected.size() &&
+                    std::equal(compacted.begin(), compacted.end(), expected.begin(),
+                               [](const Rectangle& a, const Rectangle& b) {
+                                   return !(a < b) && !(b < a) && a.area == b.area &&
+                                          a.distanceSquared == b.distanceSquared;
+                               });
+        std::cout << "  Capacity " << capacity << ": " << logged << " lines logged, " << compacted.size()
+                  << " after compaction, store holds " << expected.size() << "\n";
+        passed = passed && same && !expected.empty();
+        std::filesystem::remove(path);
+    }
+
+    if (passed) {
+        std::cout << "[PASS] Compacted log matches the result store\n";
+    } else {
+        std::cout << "[FAIL] Compacted log differs from the result store\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return passed;
+}
+
+bool testStageMetrics() {
+    const int64_t TEST_WORLD_SEED = 413563856LL;
+
+    std::cout << "Testing per-stage counters...\n";
+    std::cout << "========================================\n";
+
+    int64_t searchMinX = -1000 * 16;
+    int64_t searchMaxX = 1500 * 16;
+    int64_t searchMinZ = -900 * 16;
+    int64_t searchMaxZ = 1200 * 16;
+    const int64_t unitSize = 200;
+
+    EngineConfig engines;
+    engines.simdLevel = detectSimdLevel();
+    engines.rectFilter = RectFilter::None;
+    StageMetrics metrics(2);
+
+    auto runSearch = [&](const EngineConfig& config) {
+        RectangleStore results;
+        std::atomic<bool> pauseFlag{false};
+        std::atomic<int64_t> chunksProcessed{0};
+        std::atomic<int64_t> maxDistanceReached{0};
+        SpiralWorkQueue workQueue(searchMinX, searchMaxX, searchMinZ, searchMaxZ, unitSize);
+        WorkProgress progress(workQueue.size());
+        SeamTracker seams(workQueue, progress);
+        std::vector<std::thread> threads;
+        for (int64_t i = 0; i < 2; i++) {
+            threads.emplace_back(workerThread, i, 2, TEST_WORLD_SEED, 2,
+                                 searchMinX, searchMaxX, searchMinZ, searchMaxZ,
+                                 std::ref(results), std::ref(pauseFlag), std::ref(chunksProcessed),
+                                 std::ref(maxDistanceReached), std::ref(workQueue), std::ref(progress),
+                                 std::ref(seams), std::cref(config), false);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return results.size();
+    };
+
+    // Seam tiling fills every row of every unit exactly once
+    SpiralWorkQueue units(searchMinX, searchMaxX, searchMinZ, searchMaxZ, unitSize);
+    uint64_t expectedRows = 0;
+    for (int64_t i = 0; i < units.size(); i++) {
+        WorkUnit unit = units.unitAt(i);
+        expectedRows += (uint64_t)(unit.maxZ - unit.minZ);
+    }
+
+    EngineConfig timed = engines;
+    timed.metrics = &metrics;
+    int64_t stored = runSearch(timed);
+    StageMetrics::Totals totals = metrics.total();
+
+    // A search without metrics must leave the counters alone
+    runSearch(engines);
+    StageMetrics::Totals after = metrics.total();
+
+    bool passed = true;
+    std::cout << "  Fill rows: " << totals.calls[(int)Stage::Fill] << " (expected " << expectedRows << ")\n";
+    std::cout << "  Rectangles merged: " << totals.rectangles << ", stored " << stored << "\n";
+    std::cout << "  Breakdown: " << metrics.breakdown() << "\n";
+    passed = passed && totals.calls[(int)Stage::Fill] == expectedRows;
+    passed = passed && totals.calls[(int)Stage::Heights] >= expectedRows;
+    passed = passed && totals.cycles[(int)Stage::Fill] > 0 && totals.calls[(int)Stage::Merge] > 0;
+    passed = passed && totals.rectangles >= (uint64_t)stored && stored > 0;
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        passed = passed && after.calls[i] == totals.calls[i] && after.cycles[i] == totals.cycles[i];
+    }
+
+    if (passed) {
+        std::cout << "[PASS] Stage counters add up and stay unbound afterwards\n";
+    } else {
+        std::cout << "[FAIL] Stage counters are off\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return passed;
+}
+
+bool testUnitArena() {
+    const int64_t TEST_WORLD_SEED = 413563856LL;
+    const int64_t minimumRectDimension = 3;
+
+    std::cout << "Testing reusable unit arenas...\n";
+    std::cout << "========================================\n";
+
+    int64_t searchMinX = -700 * 16;
+    int64_t searchMaxX = 500 * 16;
+    int64_t searchMinZ = -400 * 16;
+    int64_t searchMaxZ = 650 * 16;
+    const int64_t unitSize = 200;
+    SpiralWorkQueue units(searchMinX, searchMaxX, searchMinZ, searchMaxZ, unitSize);
+    auto sameRectangles = [](const std::vector<Rectangle>& a, const std::vector<Rectangle>& b) {
+        return a.size() == b.size() &&
+               std::equal(a.begin(), a.end(), b.begin(),
+                          [](const Rectangle& x, const Rectangle& y) { return !(x < y) && !(y < x); });
+    };
+
+    bool passed = true;
+    for (RectFilter rectFilter : {RectFilter::None, RectFilter::SquareAnd}) {
+        EngineConfig engines;
+        engines.simdLevel = detectSimdLevel();
+        engines.rectFilter = rectFilter;
+
+        // Sized up front it never grows; empty it grows on the first unit only
+        int64_t side = paddedUnitSide(unitSize, minimumRectDimension);
+        UnitArena sized(side, side, engines.simdLevel);
+        UnitArena grown;
+        int64_t warmAllocations = -1;
+        bool same = true;
+
+        // Multi-seed batches keep one sized arena per seed
+        const std::vector<int64_t> seeds = {TEST_WORLD_SEED, -1LL, 12345LL};
+        const std::vector<int64_t> seedDimensions(seeds.size(), minimumRectDimension);
+        const std::vector<int64_t> seedAreas(seeds.size(), 0);
+        std::vector<std::unique_ptr<UnitArena>> seedArenas;
+        for (size_t k = 0; k < seeds.size(); k++) {
+            seedArenas.push_back(std::make_unique<UnitArena>(side, side, engines.simdLevel));
+        }
+        for (int64_t i = 0; i < units.size(); i++) {
+            WorkUnit unit = units.unitAt(i);
+            std::atomic<int64_t> chunksProcessed{0};
+            std::vector<Rectangle> plain, reused, seamed, seamedReused;
+            processRegion(unit.minX, unit.maxX, unit.minZ, unit.maxZ, TEST_WORLD_SEED, minimumRectDimension, 0,
+                          searchMinX, searchMaxX, searchMinZ, searchMaxZ, plain, chunksProcessed, engines);
+            processRegion(unit.minX, unit.maxX, unit.minZ, unit.maxZ, TEST_WORLD_SEED, minimumRectDimension, 0,
+                          searchMinX, searchMaxX, searchMinZ, searchMaxZ, reused, chunksProcessed, engines,
+                          false, &sized);
+            UnitEdges edges, edgesReused;
+            processUnitSeamed(unit, TEST_WORLD_SEED, minimumRectDimension, 0, edges, seamed, true, engines);
+            processUnitSeamed(unit, TEST_WORLD_SEED, minimumRectDimension, 0, edgesReused, seamedReused, true,
+                              engines, false, &grown);
+            std::vector<std::vector<Rectangle>> batched(seeds.size()), batchedReused(seeds.size());
+            processRegionMultiSeed(unit.minX, unit.maxX, unit.minZ, unit.maxZ, seeds, minimumRectDimension,
+                                   seedDimensions, seedAreas, searchMinX, searchMaxX, searchMinZ, searchMaxZ,
+                                   batched, chunksProcessed, engines);
+            processRegionMultiSeed(unit.minX, unit.maxX, unit.minZ, unit.maxZ, seeds, minimumRectDimension,
+                                   seedDimensions, seedAreas, searchMinX, searchMaxX, searchMinZ, searchMaxZ,
+                                   batchedReused, chunksProcessed, engines, false, &seedArenas);
+            same = same && sameRectangles(plain, reused) && sameRectangles(seamed, seamedReused) &&
+                   edges.topDepths == edgesReused.topDepths && edges.rightRuns == edgesReused.rightRuns &&
+                   sameRectangles(batched[0], plain);
+            for (size_t k = 0; k < seeds.size(); k++) {
+                same = same && sameRectangles(batched[k], batchedReused[k]);
+            }
+            if (i == 0) {
+                warmAllocations = grown.allocations();
+            }
+        }
+
+        int64_t seedAllocations = 0;
+        for (const auto& arena : seedArenas) {
+            seedAllocations += arena->allocations();
+        }
+        std::cout << "  " << rectFilterName(rectFilter) << ": sized arena " << sized.allocations()
+                  << " allocations, empty arena " << grown.allocations() << " (" << warmAllocations
+                  << " on the first unit), " << grown.bytes() << " bytes, per-seed arenas "
+                  << seedAllocations << " allocations\n";
+        passed = passed && same && sized.allocations() == 0 && seedAllocations == 0 &&
+                 warmAllocations > 0 && grown.allocations() == warmAllocations;
+    }
+
+    if (passed) {
+        std::cout << "[PASS] Arenas reproduce per-unit results without allocating once warm\n";
+    } else {
+        std::cout << "[FAIL] Arena results or allocation counts are off\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return passed;
+}
+
+bool runUnitTests(GridEngine gridEngine, SimdLevel simdLevel) {
     // Set test-specific configuration
     const int64_t TEST_WORLD_SEED = 413563856LL;
     const int64_t TEST_MINIMUM_RECT_DIMENSION = 3;
 
-    std::cout << "Running unit tests...\n";
+    std::cout << "Running unit tests (grid engine: " << gridEngineName(gridEngine)
+              << ", simd: " << simdLevelName(simdLevel) << ")...\n";
     std::cout << "========================================\n";
 
     // Test case: 3x3 at chunk (1495-1497, 8282-8284)
@@ -116,27 +1799,29 @@ bool runUnitTests() {
               << "] Z[" << (testSearchMinZ/16) << " to " << (testSearchMaxZ/16) << "]\n";
 
     // Create local state variables
-    std::mutex resultsMutex;
-    std::set<Rectangle> foundRectangles;
+    RectangleStore results;
     std::atomic<bool> pauseFlag{false};
     std::atomic<int64_t> chunksProcessed{0};
     std::atomic<int64_t> maxDistanceReached{0};
-    std::vector<std::pair<std::pair<int64_t, int64_t>, std::pair<int64_t, int64_t>>> workQueue;
-    std::atomic<int64_t> workQueueIndex{0};
+    EngineConfig engines;
+    engines.simdLevel = simdLevel;
+    engines.gridEngine = gridEngine;
 
-    // Generate work queue for this small region
-    std::cout << "Generating work queue...\n";
-    generateWorkQueue(testSearchMinX, testSearchMaxX, testSearchMinZ, testSearchMaxZ, workQueue);
+    // Work units for this small region
+    SpiralWorkQueue workQueue(testSearchMinX, testSearchMaxX, testSearchMinZ, testSearchMaxZ);
+    WorkProgress progress(workQueue.size());
+    SeamTracker seams(workQueue, progress);
     std::cout << "Work units: " << workQueue.size() << "\n\n";
 
     // Run single-threaded for easier debugging (with debug mode enabled)
     std::cout << "Processing work units...\n";
     workerThread(0, 1, TEST_WORLD_SEED, TEST_MINIMUM_RECT_DIMENSION,
                  testSearchMinX, testSearchMaxX, testSearchMinZ, testSearchMaxZ,
-                 resultsMutex, foundRectangles, pauseFlag, chunksProcessed, maxDistanceReached,
-                 workQueue, workQueueIndex, true);  // Enable debug mode
+                 results, pauseFlag, chunksProcessed, maxDistanceReached,
+                 workQueue, progress, seams, engines, true);  // Enable debug mode
 
     // Check results
+    std::vector<Rectangle> foundRectangles = results.snapshot();
     std::cout << "\nRectangles found: " << foundRectangles.size() << "\n";
     for (const auto& rect : foundRectangles) {
         std::cout << "  " << rect.width << "x" << rect.height
@@ -165,16 +1850,85 @@ bool runUnitTests() {
     return found3x3;
 }
 
+bool testLargestMode() {
+    const int64_t TEST_WORLD_SEED = 413563856LL;
+
+    std::cout << "Testing largest-rectangle search mode...\n";
+    std::cout << "========================================\n";
+
+    // Starting from 1x1, the adaptive run must end on the same best shorter side as an
+    // exhaustive run, and report the rectangles with that shorter side
+    int64_t searchMinX = 1200 * 16;
+    int64_t searchMaxX = 2400 * 16;
+    int64_t searchMinZ = 7400 * 16;
+    int64_t searchMaxZ = 8500 * 16;
+
+    std::vector<Rectangle> found[2];
+    int64_t bestShortSide[2] = {0, 0};
+    const SearchMode modes[2] = {SearchMode::Exhaustive, SearchMode::Largest};
+
+    for (int m = 0; m < 2; m++) {
+        RectangleStore results;
+        std::atomic<bool> pauseFlag{false};
+        std::atomic<int64_t> chunksProcessed{0};
+        std::atomic<int64_t> maxDistanceReached{0};
+        EngineConfig engines;
+        engines.simdLevel = detectSimdLevel();
+        engines.searchMode = modes[m];
+
+        SpiralWorkQueue workQueue(searchMinX, searchMaxX, searchMinZ, searchMaxZ);
+        WorkProgress progress(workQueue.size());
+        SeamTracker seams(workQueue, progress);
+        workerThread(0, 1, TEST_WORLD_SEED, 1, searchMinX, searchMaxX, searchMinZ, searchMaxZ,
+                     results, pauseFlag, chunksProcessed, maxDistanceReached, workQueue, progress, seams, engines);
+        found[m] = results.snapshot();
+        bestShortSide[m] = results.bestShortSide();
+    }
+
+    int64_t bestExhaustive = 0;
+    for (const auto& rect : found[0]) {
+        bestExhaustive = std::max(bestExhaustive, std::min(rect.width, rect.height));
+    }
+    bool hasBest = std::any_of(found[1].begin(), found[1].end(), [&](const Rectangle& rect) {
+        return std::min(rect.width, rect.height) == bestExhaustive;
+    });
+
+    std::cout << "  Exhaustive: " << found[0].size() << " rectangles, best shorter side " << bestExhaustive << "\n";
+    std::cout << "  Largest:    " << found[1].size() << " rectangles, best shorter side " << bestShortSide[1] << "\n";
+
+    bool passed = (bestShortSide[0] == bestExhaustive) && (bestShortSide[1] == bestExhaustive) &&
+                  hasBest && found[1].size() < found[0].size();
+    if (passed) {
+        std::cout << "[PASS] Largest mode converges on the best shorter side\n";
+    } else {
+        std::cout << "[FAIL] Largest mode missed the best rectangle\n";
+    }
+
+    std::cout << "========================================\n\n";
+    return passed;
+}
+
 int main(int argc, char* argv[]) {
     // First test PRNG optimizations
-    bool optimizationsOK = testOptimizations();
+    bool optimizationsOK = testOptimizations() && testVectorKernelSweep() && testRowKernel() &&
+                           testHeightKernels() && testSquareFilter() &&
+                           testMaximalRectangles() && testExhaustiveRectangles() && testTopKStore() &&
+                           testSpiralWorkQueue() && testWorkStealing() &&
+                           testCheckpointResume() && testSeamTiling() && testPaddedTiling() && testMultiSeed() &&
+                           testSeedSweep() && testBitmapCache() && testResultLog() &&
+                           testStageMetrics() && testUnitArena();
     if (!optimizationsOK) {
         std::cout << "CRITICAL: PRNG optimizations failed. Aborting tests.\n";
         return 1;
     }
 
-    // Then run full integration tests
-    bool integrationOK = runUnitTests();
+    // Then run full integration tests with every kernel this CPU supports
+    bool integrationOK = true;
+    for (int level = 0; level <= (int)detectSimdLevel(); level++) {
+        integrationOK = runUnitTests(GridEngine::Batch, (SimdLevel)level) && integrationOK;
+        integrationOK = runUnitTests(GridEngine::RowIncremental, (SimdLevel)level) && integrationOK;
+    }
+    integrationOK = testLargestMode() && integrationOK;
 
     return integrationOK ? 0 : 1;
 }